@@ -38,6 +38,9 @@ public class DynamicObjectPooler : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"NetCore",
+				"DeveloperSettings",
+				"Json",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -1,12 +1,19 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "DynamicObjectPooler.h"
+#include "Engine/AssetManager.h"
+#include "ObjectPoolConfig.h"
 
 #define LOCTEXT_NAMESPACE "FDynamicObjectPoolerModule"
 
+DEFINE_LOG_CATEGORY(LogObjectPool);
+
 void FDynamicObjectPoolerModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+
+	// Registered here rather than in a project's asset manager settings, so every project using the plugin finds and cooks its pool configs
+	UAssetManager::CallOrRegister_OnAssetManagerCreated(FSimpleMulticastDelegate::FDelegate::CreateStatic(&FDynamicObjectPoolerModule::RegisterPoolConfigAssetType));
 }
 
 void FDynamicObjectPoolerModule::ShutdownModule()
@@ -15,6 +22,25 @@ void FDynamicObjectPoolerModule::ShutdownModule()
 	// we call this function before unloading the module.
 }
 
+void FDynamicObjectPoolerModule::RegisterPoolConfigAssetType()
+{
+	UAssetManager& AssetManager = UAssetManager::Get();
+	const FPrimaryAssetType ConfigType = UObjectPoolConfig::PrimaryAssetType;
+
+	// A project that lists the type in its own settings keeps its own directories and rules
+	FPrimaryAssetTypeInfo ExistingInfo;
+	if (AssetManager.GetPrimaryAssetTypeInfo(ConfigType, ExistingInfo))
+	{
+		return;
+	}
+
+	AssetManager.ScanPathForPrimaryAssets(ConfigType, TEXT("/Game"), UObjectPoolConfig::StaticClass(), false);
+
+	FPrimaryAssetRules Rules;
+	Rules.CookRule = EPrimaryAssetCookRule::AlwaysCook;
+	AssetManager.SetPrimaryAssetTypeRules(ConfigType, Rules);
+}
+
 #undef LOCTEXT_NAMESPACE
 	
 IMPLEMENT_MODULE(FDynamicObjectPoolerModule, DynamicObjectPooler)
\ No newline at end of file
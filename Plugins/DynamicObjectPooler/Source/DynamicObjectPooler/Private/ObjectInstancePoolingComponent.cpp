@@ -0,0 +1,360 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+
+#include "ObjectInstancePoolingComponent.h"
+#include "DynamicObjectPooler.h"
+#include "ObjectPoolStats.h"
+#include "PooledActorInterface.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DEFINE_STAT(STAT_ObjectPool_AcquireObject);
+DEFINE_STAT(STAT_ObjectPool_ReleaseObject);
+
+CSV_DECLARE_CATEGORY_EXTERN(ObjectPool);
+
+TRACE_DECLARE_INT_COUNTER(ObjectPool_ActiveInstances, TEXT("ObjectPool/ActiveInstances"));
+TRACE_DECLARE_INT_COUNTER(ObjectPool_InactiveInstances, TEXT("ObjectPool/InactiveInstances"));
+
+namespace ObjectInstancePoolCounters
+{
+	/* Totals across every instance pool, kept apart from the actor pool totals.  Only touched on the game thread */
+	int32 TotalActiveInstances = 0;
+	int32 TotalInactiveInstances = 0;
+}
+
+UObjectInstancePoolingComponent::UObjectInstancePoolingComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UObjectInstancePoolingComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Pooled components live on the owner, so take them down with the pool
+	for (UObject* Object : Pool)
+	{
+		if (UActorComponent* Component = Cast<UActorComponent>(Object); IsValid(Component))
+		{
+			Component->DestroyComponent();
+		}
+	}
+
+	Pool.Reset();
+	FreeSlots.Reset();
+	SlotInUse.Reset();
+	SlotLookup.Reset();
+	DeadSlots.Reset();
+	ActiveObjects = 0;
+	UpdateInactiveObjects();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UObjectInstancePoolingComponent::InitializePool(TSubclassOf<UObject> ObjectClass, int32 InitialSize)
+{
+	if (!ObjectClass || ObjectClass->IsChildOf(AActor::StaticClass()) || ObjectClass->HasAnyClassFlags(CLASS_Abstract))
+	{
+		UE_LOG(LogObjectPool, Error, TEXT("InitializePool needs a concrete component or object class, actors are pooled by UObjectPoolingComponent."));
+		return;
+	}
+
+	PooledObjectClass = ObjectClass;
+	bImplementsPooledInterface = ObjectClass->ImplementsInterface(UPooledActorInterface::StaticClass());
+
+	ExpandPool(InitialSize);
+}
+
+void UObjectInstancePoolingComponent::ExpandPool(int32 Count)
+{
+	OBJECTPOOL_SCOPE_CYCLE_COUNTER(STAT_ObjectPool_ExpandPool);
+
+	if (!PooledObjectClass || !GetOwner()) return;
+
+	if (MaxPoolSize > 0)
+	{
+		Count = FMath::Min(Count, MaxPoolSize - GetNumPooledObjects());
+	}
+	if (Count <= 0) return;
+
+	const bool bIsComponentClass = PooledObjectClass->IsChildOf(UActorComponent::StaticClass());
+
+	const int32 NewSlots = FMath::Max(Count - DeadSlots.Num(), 0);
+	Pool.Reserve(Pool.Num() + NewSlots);
+	SlotInUse.Reserve(SlotInUse.Num() + NewSlots);
+	FreeSlots.Reserve(FreeSlots.Num() + Count);
+	SlotLookup.Reserve(SlotLookup.Num() + Count);
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		// Components belong to the owner so they can register with its world, plain objects are kept alive by the pool
+		UObject* NewObjectInstance = NewObject<UObject>(bIsComponentClass ? static_cast<UObject*>(GetOwner()) : this, PooledObjectClass);
+
+		if (UActorComponent* Component = Cast<UActorComponent>(NewObjectInstance))
+		{
+			// Registering is the expensive part, so it happens once here instead of on every acquire
+			Component->bAutoActivate = false;
+			Component->RegisterComponent();
+			DeactivateObject(Component);
+		}
+
+		int32 SlotIndex;
+		if (DeadSlots.Num() > 0)
+		{
+			SlotIndex = DeadSlots.Pop(EAllowShrinking::No);
+			Pool[SlotIndex] = NewObjectInstance;
+		}
+		else
+		{
+			SlotIndex = Pool.Add(NewObjectInstance);
+			SlotInUse.Add(false);
+		}
+		FreeSlots.Push(SlotIndex);
+		SlotLookup.Add(NewObjectInstance, SlotIndex);
+
+		CSV_CUSTOM_STAT(ObjectPool, Expansions, 1, ECsvCustomStatOp::Accumulate);
+		TotalObjectsCreated++;
+		TotalPoolExpansions++;
+	}
+
+	UpdateInactiveObjects();
+}
+
+UObject* UObjectInstancePoolingComponent::AcquireObject()
+{
+	UObject* Object = AcquireFromPool();
+	if (Object)
+	{
+		ActivateObject(Object, nullptr, nullptr);
+	}
+	return Object;
+}
+
+UActorComponent* UObjectInstancePoolingComponent::AcquireComponent(const FTransform& WorldTransform, USceneComponent* AttachParent)
+{
+	if (!PooledObjectClass || !PooledObjectClass->IsChildOf(UActorComponent::StaticClass()))
+	{
+		UE_CLOG(PooledObjectClass != nullptr, LogObjectPool, Warning, TEXT("AcquireComponent was called on a pool of %s, which is not a component class."), *PooledObjectClass->GetName());
+		return nullptr;
+	}
+
+	UObject* Object = AcquireFromPool();
+	if (Object)
+	{
+		ActivateObject(Object, &WorldTransform, AttachParent);
+	}
+	return Cast<UActorComponent>(Object);
+}
+
+UObject* UObjectInstancePoolingComponent::AcquireFromPool()
+{
+	OBJECTPOOL_SCOPE_CYCLE_COUNTER(STAT_ObjectPool_AcquireObject);
+
+	TotalSpawnRequests++;
+
+	// Only acquires that find an idle object right away count as hits
+	const bool bHadFreeSlot = FreeSlots.Num() > 0;
+
+	while (FreeSlots.Num() > 0 || bAutoExpand)
+	{
+		if (FreeSlots.Num() == 0)
+		{
+			ExpandPool(1);
+			if (FreeSlots.Num() == 0)
+			{
+				break;
+			}
+		}
+
+		const int32 SlotIndex = FreeSlots.Pop(EAllowShrinking::No);
+		UObject* Object = Pool[SlotIndex];
+
+		// Components can be destroyed by their owner without the pool knowing, drop those slots
+		if (!IsValid(Object))
+		{
+			RemoveDeadSlot(SlotIndex);
+			continue;
+		}
+
+		if (bHadFreeSlot)
+		{
+			TotalPoolHits++;
+		}
+		else
+		{
+			TotalPoolMisses++;
+		}
+
+		SlotInUse[SlotIndex] = true;
+		ActiveObjects++;
+		PeakUsage = FMath::Max(PeakUsage, ActiveObjects);
+		UpdateInactiveObjects();
+		CSV_CUSTOM_STAT(ObjectPool, Spawns, 1, ECsvCustomStatOp::Accumulate);
+		return Object;
+	}
+
+	TotalPoolMisses++;
+	UE_LOG(LogObjectPool, Verbose, TEXT("No available pooled objects, and pool auto-expansion is disabled."));
+	return nullptr;
+}
+
+void UObjectInstancePoolingComponent::ReleaseObject(UObject* Object)
+{
+	OBJECTPOOL_SCOPE_CYCLE_COUNTER(STAT_ObjectPool_ReleaseObject);
+
+	const int32* SlotIndex = SlotLookup.Find(Object);
+	if (!SlotIndex || !SlotInUse[*SlotIndex])
+	{
+		UE_CLOG(Object != nullptr, LogObjectPool, Verbose, TEXT("Ignoring release of an object that is not handed out by this pool."));
+		return;
+	}
+
+	// Destroyed while handed out, the slot is recycled instead of returned
+	if (!IsValid(Object))
+	{
+		RemoveDeadSlot(*SlotIndex);
+		return;
+	}
+
+	DeactivateObject(Object);
+
+	SlotInUse[*SlotIndex] = false;
+	FreeSlots.Push(*SlotIndex);
+	ActiveObjects--;
+	UpdateInactiveObjects();
+	TotalReturnRequests++;
+
+	OnPooledObjectReleased.Broadcast(Object);
+}
+
+void UObjectInstancePoolingComponent::RemoveDeadSlot(int32 SlotIndex)
+{
+	if (SlotInUse[SlotIndex])
+	{
+		SlotInUse[SlotIndex] = false;
+		ActiveObjects--;
+	}
+
+	if (SlotLookup.Remove(Pool[SlotIndex]) == 0)
+	{
+		// Garbage collection already nulled the object, so the entry can only be found by its slot
+		for (TMap<const UObject*, int32>::TIterator It = SlotLookup.CreateIterator(); It; ++It)
+		{
+			if (It.Value() == SlotIndex)
+			{
+				It.RemoveCurrent();
+				break;
+			}
+		}
+	}
+
+	Pool[SlotIndex] = nullptr;
+	DeadSlots.Push(SlotIndex);
+	UpdateInactiveObjects();
+}
+
+void UObjectInstancePoolingComponent::UpdateInactiveObjects()
+{
+	InactiveObjects = GetNumPooledObjects() - ActiveObjects;
+	PublishPoolCounters(ActiveObjects, InactiveObjects);
+}
+
+void UObjectInstancePoolingComponent::PublishPoolCounters(int32 Active, int32 Inactive)
+{
+	using namespace ObjectInstancePoolCounters;
+
+	// Apply this pool's change to the totals
+	TotalActiveInstances += Active - ReportedActiveObjects;
+	TotalInactiveInstances += Inactive - ReportedInactiveObjects;
+	ReportedActiveObjects = Active;
+	ReportedInactiveObjects = Inactive;
+
+	TRACE_COUNTER_SET(ObjectPool_ActiveInstances, TotalActiveInstances);
+	TRACE_COUNTER_SET(ObjectPool_InactiveInstances, TotalInactiveInstances);
+
+	CSV_CUSTOM_STAT(ObjectPool, ActiveInstances, TotalActiveInstances, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(ObjectPool, InactiveInstances, TotalInactiveInstances, ECsvCustomStatOp::Set);
+}
+
+void UObjectInstancePoolingComponent::ActivateObject(UObject* Object, const FTransform* WorldTransform, USceneComponent* AttachParent)
+{
+	bool bHandledByObject = false;
+	if (bImplementsPooledInterface)
+	{
+		{
+			OBJECTPOOL_SCOPE_CYCLE_COUNTER(STAT_ObjectPool_ResetPooledActor);
+			IPooledActorInterface::Execute_ResetPooledActor(Object);
+		}
+
+		// Without a requested transform the object stays where it is, so implementations that apply the transform do not snap to the origin
+		FTransform ActivationTransform = FTransform::Identity;
+		if (WorldTransform)
+		{
+			ActivationTransform = *WorldTransform;
+		}
+		else if (const USceneComponent* SceneComponent = Cast<USceneComponent>(Object))
+		{
+			ActivationTransform = SceneComponent->GetComponentTransform();
+		}
+		else if (const UActorComponent* Component = Cast<UActorComponent>(Object); Component && Component->GetOwner())
+		{
+			ActivationTransform = Component->GetOwner()->GetActorTransform();
+		}
+
+		bHandledByObject = IPooledActorInterface::Execute_ActivatePooledActor(Object, ActivationTransform);
+	}
+
+	if (!bHandledByObject)
+	{
+		if (USceneComponent* SceneComponent = Cast<USceneComponent>(Object))
+		{
+			if (WorldTransform)
+			{
+				SceneComponent->SetWorldTransform(*WorldTransform, false, nullptr, ETeleportType::TeleportPhysics);
+			}
+			if (AttachParent)
+			{
+				SceneComponent->AttachToComponent(AttachParent, FAttachmentTransformRules::KeepWorldTransform);
+			}
+			SceneComponent->SetHiddenInGame(false);
+		}
+
+		// Niagara restarts its system and audio starts playing on activation
+		if (UActorComponent* Component = Cast<UActorComponent>(Object))
+		{
+			Component->Activate(true);
+		}
+	}
+
+	OnPooledObjectAcquired.Broadcast(Object);
+}
+
+void UObjectInstancePoolingComponent::DeactivateObject(UObject* Object)
+{
+	bool bHandledByObject = false;
+	if (bImplementsPooledInterface)
+	{
+		bHandledByObject = IPooledActorInterface::Execute_DeactivatePooledActor(Object);
+	}
+
+	if (bHandledByObject)
+	{
+		return;
+	}
+
+	if (UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		// Deactivating also stops the component ticking
+		Component->Deactivate();
+	}
+
+	if (USceneComponent* SceneComponent = Cast<USceneComponent>(Object))
+	{
+		SceneComponent->SetHiddenInGame(true);
+		if (SceneComponent->GetAttachParent())
+		{
+			SceneComponent->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+		}
+	}
+}
@@ -0,0 +1,82 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+
+#include "ObjectPoolConfig.h"
+#include "DynamicObjectPooler.h"
+#include "UObject/ObjectSaveContext.h"
+
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+#endif
+
+#define LOCTEXT_NAMESPACE "ObjectPoolConfig"
+
+const FPrimaryAssetType UObjectPoolConfig::PrimaryAssetType(TEXT("ObjectPoolConfig"));
+
+FPrimaryAssetId UObjectPoolConfig::GetPrimaryAssetId() const
+{
+	// One primary asset type for every config, scanned by the asset manager so configs are always cooked
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
+
+#if WITH_EDITOR
+EDataValidationResult UObjectPoolConfig::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = Super::IsDataValid(Context);
+
+	TSet<FSoftObjectPath> SeenClasses;
+	for (int32 Index = 0; Index < Pools.Num(); ++Index)
+	{
+		const FObjectPoolDefinition& Definition = Pools[Index];
+
+		if (Definition.ActorClass.IsNull())
+		{
+			Context.AddError(FText::Format(LOCTEXT("MissingClass", "Pool {0} has no actor class."), Index));
+			Result = EDataValidationResult::Invalid;
+			continue;
+		}
+
+		bool bAlreadySeen = false;
+		SeenClasses.Add(Definition.ActorClass.ToSoftObjectPath(), &bAlreadySeen);
+		if (bAlreadySeen)
+		{
+			Context.AddError(FText::Format(LOCTEXT("DuplicateClass", "{0} is pooled more than once, every class has a single shared pool."), FText::FromString(Definition.ActorClass.ToString())));
+			Result = EDataValidationResult::Invalid;
+		}
+
+		if (Definition.MaxSize > 0 && (Definition.MinSize > Definition.MaxSize || Definition.InitialSize > Definition.MaxSize))
+		{
+			Context.AddError(FText::Format(LOCTEXT("SizeOverMax", "{0} has a min or initial size above its max size."), FText::FromString(Definition.ActorClass.ToString())));
+			Result = EDataValidationResult::Invalid;
+		}
+	}
+
+	if (Result == EDataValidationResult::NotValidated)
+	{
+		Result = EDataValidationResult::Valid;
+	}
+	return Result;
+}
+
+void UObjectPoolConfig::PreSave(FObjectPreSaveContext SaveContext)
+{
+	Super::PreSave(SaveContext);
+
+	// Catch broken configs at cook time instead of as a missing pool in game
+	if (SaveContext.IsCooking())
+	{
+		FDataValidationContext Context;
+		if (IsDataValid(Context) == EDataValidationResult::Invalid)
+		{
+			TArray<FText> Warnings, Errors;
+			Context.SplitIssues(Warnings, Errors);
+			for (const FText& Error : Errors)
+			{
+				UE_LOG(LogObjectPool, Error, TEXT("%s: %s"), *GetPathName(), *Error.ToString());
+			}
+		}
+	}
+}
+#endif
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,292 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "ObjectPoolingComponent.h"
+#include "ObjectInstancePoolingComponent.h"
+#include "DynamicObjectPooler.h"
+#include "Containers/Ticker.h"
+#include "Debug/DebugDrawService.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectIterator.h"
+
+/**
+ * Runtime view of every live pool in a world, for sizing pools from playtest data:
+ *
+ *   ObjectPool.Dump                 Logs one line per pool
+ *   ObjectPool.Export               Writes the same data as JSON to Saved/Profiling/ObjectPool
+ *   ObjectPool.Overlay 1            Draws the table on screen
+ *   ObjectPool.ExportInterval 10    Appends a CSV row per pool every 10 seconds, 0 stops it
+ *
+ * Pools hold their actors on the server, so run these in a standalone game or on the listen server.
+ * Shared pools are listed once, components forwarding to them are skipped.
+ */
+namespace ObjectPoolDashboard
+{
+	struct FPoolRow
+	{
+		FString Name;
+		FString Class;
+		int32 Live = 0;
+		int32 Active = 0;
+		int32 Peak = 0;
+		int32 Hits = 0;
+		int32 Misses = 0;
+		int32 Expansions = 0;
+		int32 Evictions = 0;
+		float P50 = 0.f;
+		float P95 = 0.f;
+		float P99 = 0.f;
+
+		float GetHitRate() const { return Hits + Misses > 0 ? static_cast<float>(Hits) / (Hits + Misses) : 1.f; }
+	};
+
+	static void GatherPools(const UWorld* World, TArray<FPoolRow>& OutRows)
+	{
+		for (TObjectIterator<UObjectPoolingComponent> It; It; ++It)
+		{
+			const UObjectPoolingComponent* Pool = *It;
+			if (Pool->GetWorld() != World || Pool->IsTemplate() || Pool->GetSharedPool() || !Pool->GetPooledObjectClass())
+			{
+				continue;
+			}
+
+			FPoolRow& Row = OutRows.AddDefaulted_GetRef();
+			Row.Name = FString::Printf(TEXT("%s.%s"), *GetNameSafe(Pool->GetOwner()), *Pool->GetName());
+			Row.Class = Pool->GetPooledObjectClass()->GetName();
+			Row.Live = Pool->GetNumPooledActors();
+			Row.Active = Pool->ActiveObjects;
+			Row.Peak = Pool->PeakUsage;
+			Row.Hits = Pool->TotalPoolHits;
+			Row.Misses = Pool->TotalPoolMisses;
+			Row.Expansions = Pool->TotalPoolExpansions;
+			Row.Evictions = Pool->TotalEvictions;
+			Row.P50 = Pool->GetAcquireLatencyPercentile(0.5f);
+			Row.P95 = Pool->GetAcquireLatencyPercentile(0.95f);
+			Row.P99 = Pool->GetAcquireLatencyPercentile(0.99f);
+		}
+
+		// Instance pools do not time their acquires
+		for (TObjectIterator<UObjectInstancePoolingComponent> It; It; ++It)
+		{
+			const UObjectInstancePoolingComponent* Pool = *It;
+			if (Pool->GetWorld() != World || Pool->IsTemplate() || !Pool->GetPooledObjectClass())
+			{
+				continue;
+			}
+
+			FPoolRow& Row = OutRows.AddDefaulted_GetRef();
+			Row.Name = FString::Printf(TEXT("%s.%s"), *GetNameSafe(Pool->GetOwner()), *Pool->GetName());
+			Row.Class = Pool->GetPooledObjectClass()->GetName();
+			Row.Live = Pool->GetNumPooledObjects();
+			Row.Active = Pool->ActiveObjects;
+			Row.Peak = Pool->PeakUsage;
+			Row.Hits = Pool->TotalPoolHits;
+			Row.Misses = Pool->TotalPoolMisses;
+			Row.Expansions = Pool->TotalPoolExpansions;
+		}
+
+		OutRows.Sort([](const FPoolRow& A, const FPoolRow& B) { return A.Live > B.Live; });
+	}
+
+	static FString FormatRow(const FPoolRow& Row)
+	{
+		return FString::Printf(TEXT("%-40s %-28s %6d/%-6d peak %6d  hit %5.1f%%  miss %6d  grow %5d  evict %5d  p50 %7.2fus  p95 %7.2fus  p99 %7.2fus"),
+			*Row.Name, *Row.Class, Row.Active, Row.Live, Row.Peak, Row.GetHitRate() * 100.f, Row.Misses, Row.Expansions, Row.Evictions, Row.P50, Row.P95, Row.P99);
+	}
+
+	static FString GetExportPath(const TCHAR* Prefix, const TCHAR* Extension)
+	{
+		return FPaths::ProfilingDir() / TEXT("ObjectPool") / FString::Printf(TEXT("%s-%s.%s"), Prefix, *FDateTime::Now().ToString(), Extension);
+	}
+
+	/* Game and PIE worlds that pools can live in */
+	static void GetGameWorlds(TArray<UWorld*>& OutWorlds)
+	{
+		if (!GEngine) return;
+
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			if (Context.World() && Context.World()->IsGameWorld())
+			{
+				OutWorlds.Add(Context.World());
+			}
+		}
+	}
+
+	/* Overlay */
+
+	static FDelegateHandle OverlayHandle;
+
+	static void DrawOverlay(UCanvas* Canvas, APlayerController* PlayerController)
+	{
+		if (!Canvas || !PlayerController) return;
+
+		TArray<FPoolRow> Rows;
+		GatherPools(PlayerController->GetWorld(), Rows);
+
+		UFont* Font = GEngine->GetSmallFont();
+		float Y = 80.f;
+		Canvas->SetDrawColor(FColor::Emerald);
+		Canvas->DrawText(Font, FString::Printf(TEXT("Object Pools (%d)"), Rows.Num()), 20.f, Y);
+		Y += 14.f;
+
+		for (const FPoolRow& Row : Rows)
+		{
+			// Pools that drop spawns or grow under load stand out
+			Canvas->SetDrawColor(Row.GetHitRate() < 0.95f ? FColor::Orange : FColor::White);
+			Canvas->DrawText(Font, FormatRow(Row), 20.f, Y);
+			Y += 12.f;
+		}
+	}
+
+	static int32 GOverlayEnabled = 0;
+	static FAutoConsoleVariableRef CVarOverlay(
+		TEXT("ObjectPool.Overlay"),
+		GOverlayEnabled,
+		TEXT("Draws every live pool with occupancy, hit rate, growth and acquire latency on screen."),
+		FConsoleVariableDelegate::CreateLambda([](IConsoleVariable*)
+		{
+			if (GOverlayEnabled && !OverlayHandle.IsValid())
+			{
+				OverlayHandle = UDebugDrawService::Register(TEXT("Game"), FDebugDrawDelegate::CreateStatic(&DrawOverlay));
+			}
+			else if (!GOverlayEnabled && OverlayHandle.IsValid())
+			{
+				UDebugDrawService::Unregister(OverlayHandle);
+				OverlayHandle.Reset();
+			}
+		}));
+
+	/* Periodic export */
+
+	static FTSTicker::FDelegateHandle ExportTickerHandle;
+	static FString ExportFileName;
+
+	static bool ExportTelemetry(float DeltaTime)
+	{
+		TArray<UWorld*> Worlds;
+		GetGameWorlds(Worlds);
+
+		FString Csv;
+		for (const UWorld* World : Worlds)
+		{
+			TArray<FPoolRow> Rows;
+			GatherPools(World, Rows);
+			for (const FPoolRow& Row : Rows)
+			{
+				Csv += FString::Printf(TEXT("%.2f,%s,%s,%s,%d,%d,%d,%d,%d,%d,%d,%.3f,%.3f,%.3f\n"),
+					World->GetTimeSeconds(), *World->GetMapName(), *Row.Name, *Row.Class, Row.Live, Row.Active, Row.Peak,
+					Row.Hits, Row.Misses, Row.Expansions, Row.Evictions, Row.P50, Row.P95, Row.P99);
+			}
+		}
+
+		if (!Csv.IsEmpty())
+		{
+			FFileHelper::SaveStringToFile(Csv, *ExportFileName, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+		}
+		return true;
+	}
+
+	static float GExportInterval = 0.f;
+	static FAutoConsoleVariableRef CVarExportInterval(
+		TEXT("ObjectPool.ExportInterval"),
+		GExportInterval,
+		TEXT("Seconds between CSV rows of pool telemetry written to Saved/Profiling/ObjectPool.  0 stops the export."),
+		FConsoleVariableDelegate::CreateLambda([](IConsoleVariable*)
+		{
+			if (ExportTickerHandle.IsValid())
+			{
+				FTSTicker::GetCoreTicker().RemoveTicker(ExportTickerHandle);
+				ExportTickerHandle.Reset();
+			}
+
+			if (GExportInterval > 0.f)
+			{
+				// Every change of interval starts a new file
+				ExportFileName = GetExportPath(TEXT("Telemetry"), TEXT("csv"));
+				FFileHelper::SaveStringToFile(FString(TEXT("Time,Map,Pool,Class,Live,Active,Peak,Hits,Misses,Expansions,Evictions,P50Us,P95Us,P99Us\n")), *ExportFileName);
+				ExportTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&ExportTelemetry), GExportInterval);
+				UE_LOG(LogObjectPool, Display, TEXT("Writing pool telemetry every %.1f seconds to %s"), GExportInterval, *ExportFileName);
+			}
+		}));
+
+	/* Commands */
+
+	static FAutoConsoleCommandWithWorld GDumpCommand(
+		TEXT("ObjectPool.Dump"),
+		TEXT("Logs every live pool in the world with occupancy, hit rate, growth and acquire latency."),
+		FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+		{
+			TArray<FPoolRow> Rows;
+			GatherPools(World, Rows);
+
+			UE_LOG(LogObjectPool, Display, TEXT("%d pools in %s"), Rows.Num(), *GetNameSafe(World));
+			for (const FPoolRow& Row : Rows)
+			{
+				UE_LOG(LogObjectPool, Display, TEXT("%s"), *FormatRow(Row));
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorld GExportCommand(
+		TEXT("ObjectPool.Export"),
+		TEXT("Writes every live pool in the world as JSON to Saved/Profiling/ObjectPool."),
+		FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+		{
+			TArray<FPoolRow> Rows;
+			GatherPools(World, Rows);
+
+			TArray<TSharedPtr<FJsonValue>> Pools;
+			for (const FPoolRow& Row : Rows)
+			{
+				TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+				Object->SetStringField(TEXT("Pool"), Row.Name);
+				Object->SetStringField(TEXT("Class"), Row.Class);
+				Object->SetNumberField(TEXT("Live"), Row.Live);
+				Object->SetNumberField(TEXT("Active"), Row.Active);
+				Object->SetNumberField(TEXT("Peak"), Row.Peak);
+				Object->SetNumberField(TEXT("Hits"), Row.Hits);
+				Object->SetNumberField(TEXT("Misses"), Row.Misses);
+				Object->SetNumberField(TEXT("HitRate"), Row.GetHitRate());
+				Object->SetNumberField(TEXT("Expansions"), Row.Expansions);
+				Object->SetNumberField(TEXT("Evictions"), Row.Evictions);
+				Object->SetNumberField(TEXT("P50Us"), Row.P50);
+				Object->SetNumberField(TEXT("P95Us"), Row.P95);
+				Object->SetNumberField(TEXT("P99Us"), Row.P99);
+				Pools.Add(MakeShared<FJsonValueObject>(Object));
+			}
+
+			TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+			Root->SetStringField(TEXT("Map"), World ? World->GetMapName() : FString());
+			Root->SetNumberField(TEXT("Time"), World ? World->GetTimeSeconds() : 0.0);
+			Root->SetArrayField(TEXT("Pools"), Pools);
+
+			FString Json;
+			FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Json));
+
+			const FString FileName = GetExportPath(TEXT("Pools"), TEXT("json"));
+			if (FFileHelper::SaveStringToFile(Json, *FileName))
+			{
+				UE_LOG(LogObjectPool, Display, TEXT("Pool snapshot written to %s"), *FileName);
+			}
+			else
+			{
+				UE_LOG(LogObjectPool, Error, TEXT("Failed to write pool snapshot to %s"), *FileName);
+			}
+		}));
+}
+
+#endif // !UE_BUILD_SHIPPING
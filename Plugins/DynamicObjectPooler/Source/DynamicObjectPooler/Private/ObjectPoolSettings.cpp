@@ -0,0 +1,9 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+
+#include "ObjectPoolSettings.h"
+
+UObjectPoolSettings::UObjectPoolSettings()
+{
+	CategoryName = TEXT("Plugins");
+}
@@ -0,0 +1,30 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_STATS_GROUP(TEXT("ObjectPool"), STATGROUP_ObjectPool, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Get Pooled Object"), STAT_ObjectPool_GetPooledObject, STATGROUP_ObjectPool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spawn Pooled Actor"), STAT_ObjectPool_SpawnPooledActor, STATGROUP_ObjectPool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spawn Pooled Actors (Batch)"), STAT_ObjectPool_SpawnPooledActors, STATGROUP_ObjectPool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Return Object To Pool"), STAT_ObjectPool_ReturnObjectToPool, STATGROUP_ObjectPool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Return Objects To Pool (Batch)"), STAT_ObjectPool_ReturnObjectsToPool, STATGROUP_ObjectPool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Expand Pool"), STAT_ObjectPool_ExpandPool, STATGROUP_ObjectPool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Reset Pooled Actor"), STAT_ObjectPool_ResetPooledActor, STATGROUP_ObjectPool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Process Expired Lifespans"), STAT_ObjectPool_ProcessExpiredLifespans, STATGROUP_ObjectPool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Adaptive Sizing"), STAT_ObjectPool_AdaptiveSizing, STATGROUP_ObjectPool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Drain Queued Requests"), STAT_ObjectPool_DrainQueuedRequests, STATGROUP_ObjectPool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Acquire Pooled Object"), STAT_ObjectPool_AcquireObject, STATGROUP_ObjectPool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Release Pooled Object"), STAT_ObjectPool_ReleaseObject, STATGROUP_ObjectPool, );
+
+/* Times a pool operation.  Stats builds get a cycle counter, which Insights also shows on the CPU track.
+ * Builds without stats but with tracing get a plain CPU profiler scope instead, so the event is never recorded twice */
+#if STATS
+#define OBJECTPOOL_SCOPE_CYCLE_COUNTER(Stat) SCOPE_CYCLE_COUNTER(Stat)
+#else
+#define OBJECTPOOL_SCOPE_CYCLE_COUNTER(Stat) TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
+#endif
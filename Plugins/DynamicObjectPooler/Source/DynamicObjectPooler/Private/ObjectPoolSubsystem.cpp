@@ -0,0 +1,335 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+
+#include "ObjectPoolSubsystem.h"
+#include "ObjectPoolingComponent.h"
+#include "ObjectPoolConfig.h"
+#include "ObjectPoolSettings.h"
+#include "DynamicObjectPooler.h"
+#include "Engine/World.h"
+#include "Engine/AssetManager.h"
+#include "EngineUtils.h"
+#include "UObject/UObjectIterator.h"
+
+AObjectPoolHost::AObjectPoolHost()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// Replicated so the shared pools can notify clients when they are ready
+	bReplicates = true;
+	bAlwaysRelevant = true;
+}
+
+bool UObjectPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UObjectPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Seamless travel brings the host over before the new world begins play
+	AdoptTravelledHost();
+
+	if (InWorld.GetNetMode() != NM_Client)
+	{
+		for (const TSoftObjectPtr<UObjectPoolConfig>& Config : GetDefault<UObjectPoolSettings>()->StartupPoolConfigs)
+		{
+			// The configs are small and their pooled classes load asynchronously, so loading the list here does not hitch
+			PrewarmFromConfig(Config.LoadSynchronous());
+		}
+	}
+}
+
+void UObjectPoolSubsystem::PrewarmFromConfig(const UObjectPoolConfig* Config)
+{
+	if (!Config || GetWorld()->GetNetMode() == NM_Client) return;
+
+	TArray<FSoftObjectPath> ClassesToLoad;
+	for (const FObjectPoolDefinition& Definition : Config->Pools)
+	{
+		if (Definition.ActorClass.IsNull()) continue;
+
+		PendingDefinitions.Add(Definition);
+		if (!Definition.ActorClass.Get())
+		{
+			ClassesToLoad.Add(Definition.ActorClass.ToSoftObjectPath());
+		}
+	}
+
+	// Lowest priority first so the next pool to prewarm is popped from the back
+	PendingDefinitions.StableSort([](const FObjectPoolDefinition& A, const FObjectPoolDefinition& B) { return A.Priority < B.Priority; });
+
+	if (ClassesToLoad.Num() > 0)
+	{
+		// Load every class in one request, the pools start as soon as their class is in memory
+		TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(ClassesToLoad),
+			FStreamableDelegate::CreateUObject(this, &UObjectPoolSubsystem::PrewarmNextConfigPool));
+		if (Handle.IsValid())
+		{
+			PrewarmLoadHandles.Add(Handle);
+		}
+	}
+
+	PrewarmNextConfigPool();
+}
+
+void UObjectPoolSubsystem::PrewarmNextConfigPool()
+{
+	PrewarmLoadHandles.RemoveAll([](const TSharedPtr<FStreamableHandle>& Pending) { return !Pending.IsValid() || Pending->HasLoadCompleted(); });
+
+	// One pool prewarms at a time, so the whole pass stays within a single pool's frame budget
+	while (!PrewarmingConfigPool && PendingDefinitions.Num() > 0)
+	{
+		// Highest priority pool whose class is already loaded
+		const int32 DefinitionIndex = PendingDefinitions.FindLastByPredicate([](const FObjectPoolDefinition& Definition) { return Definition.ActorClass.Get() != nullptr; });
+		if (DefinitionIndex == INDEX_NONE)
+		{
+			// Waiting for the async load to call back
+			return;
+		}
+
+		const FObjectPoolDefinition Definition = PendingDefinitions[DefinitionIndex];
+		PendingDefinitions.RemoveAt(DefinitionIndex);
+
+		UClass* ActorClass = Definition.ActorClass.Get();
+		UObjectPoolingComponent* SharedPool = FindPool(ActorClass);
+		if (SharedPool)
+		{
+			// The config is the pool's data driven setup, so it wins over whatever created the pool first
+			UE_LOG(LogObjectPool, Log, TEXT("Config settings for %s replace those of its existing shared pool."), *ActorClass->GetName());
+		}
+		else
+		{
+			SharedPool = CreatePool(ActorClass);
+			if (!SharedPool) return;
+		}
+
+		SharedPool->ApplyPoolDefinition(Definition);
+
+		if (Definition.InitialSize > 0)
+		{
+			FindOrCreatePool(ActorClass, Definition.InitialSize, nullptr, true);
+		}
+
+		if (SharedPool->IsPrewarming())
+		{
+			PrewarmingConfigPool = SharedPool;
+			SharedPool->OnPoolInitialized.AddUniqueDynamic(this, &UObjectPoolSubsystem::HandleConfigPoolPrewarmed);
+		}
+	}
+}
+
+void UObjectPoolSubsystem::HandleConfigPoolPrewarmed()
+{
+	if (PrewarmingConfigPool)
+	{
+		PrewarmingConfigPool->OnPoolInitialized.RemoveDynamic(this, &UObjectPoolSubsystem::HandleConfigPoolPrewarmed);
+		PrewarmingConfigPool = nullptr;
+	}
+
+	PrewarmNextConfigPool();
+}
+
+void UObjectPoolSubsystem::AdoptTravelledHost()
+{
+	if (IsValid(PoolHost))
+	{
+		return;
+	}
+
+	for (TActorIterator<AObjectPoolHost> It(GetWorld()); It; ++It)
+	{
+		PoolHost = *It;
+		break;
+	}
+
+	if (!PoolHost)
+	{
+		return;
+	}
+
+	TInlineComponentArray<UObjectPoolingComponent*> TravelledPools(PoolHost);
+	for (UObjectPoolingComponent* SharedPool : TravelledPools)
+	{
+		if (TSubclassOf<AActor> ActorClass = SharedPool->GetPooledObjectClass())
+		{
+			SharedPools.Add(ActorClass, SharedPool);
+		}
+	}
+
+	UE_LOG(LogObjectPool, Log, TEXT("Took over %d shared pools from the previous map."), SharedPools.Num());
+}
+
+void UObjectPoolSubsystem::PrewarmPool(TSoftClassPtr<AActor> ActorClass, int32 Count)
+{
+	if (ActorClass.IsNull() || GetWorld()->GetNetMode() == NM_Client) return;
+
+	if (UClass* LoadedClass = ActorClass.Get())
+	{
+		FindOrCreatePool(LoadedClass, Count, nullptr, true);
+		return;
+	}
+
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(ActorClass.ToSoftObjectPath(),
+		FStreamableDelegate::CreateWeakLambda(this, [this, ActorClass, Count]()
+		{
+			PrewarmLoadHandles.RemoveAll([](const TSharedPtr<FStreamableHandle>& Pending) { return !Pending.IsValid() || Pending->HasLoadCompleted(); });
+
+			if (UClass* LoadedClass = ActorClass.Get())
+			{
+				FindOrCreatePool(LoadedClass, Count, nullptr, true);
+			}
+			else
+			{
+				UE_LOG(LogObjectPool, Error, TEXT("Failed to load %s for prewarming."), *ActorClass.ToString());
+			}
+		}));
+
+	if (Handle.IsValid())
+	{
+		PrewarmLoadHandles.Add(Handle);
+	}
+}
+
+void UObjectPoolSubsystem::AddSeamlessTravelActors(UWorld* World, TArray<AActor*>& ActorList)
+{
+	UObjectPoolSubsystem* Subsystem = World ? World->GetSubsystem<UObjectPoolSubsystem>() : nullptr;
+	if (!Subsystem || World->GetNetMode() == NM_Client) return;
+
+	// Shared pools that do not travel are dropped here so the host only carries pools that still have their actors
+	bool bHostTravels = false;
+	for (auto It = Subsystem->SharedPools.CreateIterator(); It; ++It)
+	{
+		UObjectPoolingComponent* SharedPool = It.Value();
+		if (IsValid(SharedPool) && SharedPool->bKeepAcrossSeamlessTravel)
+		{
+			bHostTravels = true;
+			continue;
+		}
+
+		if (IsValid(SharedPool))
+		{
+			SharedPool->DestroyComponent();
+		}
+		It.RemoveCurrent();
+	}
+
+	if (bHostTravels && IsValid(Subsystem->PoolHost))
+	{
+		ActorList.AddUnique(Subsystem->PoolHost);
+	}
+
+	// Pools on actors the game keeps, and the shared pools on the host, bring their idle actors along
+	for (TObjectIterator<UObjectPoolingComponent> It; It; ++It)
+	{
+		UObjectPoolingComponent* Pool = *It;
+		if (Pool->GetWorld() != World || !Pool->bKeepAcrossSeamlessTravel || !ActorList.Contains(Pool->GetOwner()))
+		{
+			continue;
+		}
+
+		Pool->PrepareForSeamlessTravel(ActorList);
+	}
+}
+
+AActor* UObjectPoolSubsystem::Acquire(TSubclassOf<AActor> ActorClass, const FTransform& SpawnTransform)
+{
+	UObjectPoolingComponent* SharedPool = FindOrCreatePool(ActorClass);
+	return SharedPool ? SharedPool->SpawnPooledActor(SpawnTransform) : nullptr;
+}
+
+void UObjectPoolSubsystem::Release(AActor* Actor)
+{
+	if (!Actor) return;
+
+	if (UObjectPoolingComponent* SharedPool = FindPool(Actor->GetClass()))
+	{
+		SharedPool->ReturnObjectToPool(Actor);
+	}
+}
+
+UObjectPoolingComponent* UObjectPoolSubsystem::FindPool(TSubclassOf<AActor> ActorClass) const
+{
+	UObjectPoolingComponent* const* SharedPool = SharedPools.Find(ActorClass);
+	return SharedPool && IsValid(*SharedPool) ? *SharedPool : nullptr;
+}
+
+UObjectPoolingComponent* UObjectPoolSubsystem::FindOrCreatePool(TSubclassOf<AActor> ActorClass, int32 InitialSize, const UObjectPoolingComponent* Settings, bool bPrewarmAsync)
+{
+	// Pools are only managed on the server
+	if (!ActorClass || GetWorld()->GetNetMode() == NM_Client) return nullptr;
+
+	UObjectPoolingComponent* SharedPool = FindPool(ActorClass);
+	if (!SharedPool)
+	{
+		SharedPool = CreatePool(ActorClass);
+		if (!SharedPool) return nullptr;
+
+		if (Settings)
+		{
+			SharedPool->CopyPoolSettingsFrom(Settings);
+		}
+		else
+		{
+			// Pools created straight from Acquire have no owner configuring them, so let them grow on demand
+			SharedPool->bAutoExpand = true;
+		}
+	}
+
+	if (InitialSize <= 0)
+	{
+		InitialSize = SharedPool->GetInitialPoolSize();
+	}
+
+	// One reserve covers every requester, so only grow by what is missing.  A prewarm in flight already counts towards it
+	const int32 MissingActors = InitialSize - SharedPool->GetPrewarmTargetSize();
+	if (MissingActors > 0)
+	{
+		if (SharedPool->IsPrewarming())
+		{
+			// Joined onto the prewarm in flight, so OnPoolInitialized only fires once this requester's actors are in too
+			SharedPool->AddToPrewarm(MissingActors);
+		}
+		else if (bPrewarmAsync)
+		{
+			SharedPool->InitializePoolAsync(TSoftClassPtr<AActor>(ActorClass.Get()), MissingActors);
+		}
+		else
+		{
+			SharedPool->InitializePool(ActorClass, MissingActors);
+		}
+	}
+
+	return SharedPool;
+}
+
+UObjectPoolingComponent* UObjectPoolSubsystem::CreatePool(TSubclassOf<AActor> ActorClass)
+{
+	AObjectPoolHost* Host = GetOrSpawnHost();
+	if (!Host) return nullptr;
+
+	UObjectPoolingComponent* SharedPool = NewObject<UObjectPoolingComponent>(Host, MakeUniqueObjectName(Host, UObjectPoolingComponent::StaticClass(), ActorClass->GetFName()));
+	Host->AddInstanceComponent(SharedPool);
+	SharedPool->RegisterComponent();
+	SharedPools.Add(ActorClass, SharedPool);
+	return SharedPool;
+}
+
+AObjectPoolHost* UObjectPoolSubsystem::GetOrSpawnHost()
+{
+	AdoptTravelledHost();
+	if (IsValid(PoolHost))
+	{
+		return PoolHost;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Name = TEXT("ObjectPoolHost");
+	SpawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	PoolHost = GetWorld()->SpawnActor<AObjectPoolHost>(SpawnParams);
+	return PoolHost;
+}
@@ -2,15 +2,57 @@
 
 
 #include "ObjectPoolingComponent.h"
+#include "DynamicObjectPooler.h"
+#include "ObjectPoolConfig.h"
+#include "ObjectPoolStats.h"
 #include "PooledActorInterface.h"
+#include "ObjectPoolSubsystem.h"
+#include "PooledActorCluster.h"
 #include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
 #include "Engine/World.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/AssetManager.h"
+#include "Async/Async.h"
+#include "TimerManager.h"
+#include "UObject/UObjectArray.h"
 #include "Net/UnrealNetwork.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DEFINE_STAT(STAT_ObjectPool_GetPooledObject);
+DEFINE_STAT(STAT_ObjectPool_SpawnPooledActor);
+DEFINE_STAT(STAT_ObjectPool_SpawnPooledActors);
+DEFINE_STAT(STAT_ObjectPool_ReturnObjectToPool);
+DEFINE_STAT(STAT_ObjectPool_ReturnObjectsToPool);
+DEFINE_STAT(STAT_ObjectPool_ExpandPool);
+DEFINE_STAT(STAT_ObjectPool_ResetPooledActor);
+DEFINE_STAT(STAT_ObjectPool_ProcessExpiredLifespans);
+DEFINE_STAT(STAT_ObjectPool_AdaptiveSizing);
+DEFINE_STAT(STAT_ObjectPool_DrainQueuedRequests);
+
+CSV_DEFINE_CATEGORY(ObjectPool, true);
+
+TRACE_DECLARE_INT_COUNTER(ObjectPool_ActiveObjects, TEXT("ObjectPool/ActiveObjects"));
+TRACE_DECLARE_INT_COUNTER(ObjectPool_InactiveObjects, TEXT("ObjectPool/InactiveObjects"));
+TRACE_DECLARE_INT_COUNTER(ObjectPool_PeakUsage, TEXT("ObjectPool/PeakUsage"));
+
+namespace ObjectPoolCounters
+{
+	/* Totals across every pool, published to Insights and the CSV profiler.  Only touched on the game thread */
+	int32 TotalActiveObjects = 0;
+	int32 TotalInactiveObjects = 0;
+	int32 PeakActiveObjects = 0;
+}
+
+FOnPooledActorActivityChanged UObjectPoolingComponent::OnPooledActorActivityChanged;
 
 UObjectPoolingComponent::UObjectPoolingComponent()
 {
 
-	PrimaryComponentTick.bCanEverTick = false;
+	// Ticking is only enabled while there is per-frame work such as an async prewarm
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 
 	// Enable replication for the component
 	SetIsReplicatedByDefault(true);
@@ -21,231 +63,2153 @@ void UObjectPoolingComponent::BeginPlay()
 	Super::BeginPlay();
 }
 
-void UObjectPoolingComponent::InitializePool(TSubclassOf<AActor> ActorClass, int32 InitialSize)
+void UObjectPoolingComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	// Only initialize the object pool on the server
-	if (!IsServer())
+	// Stop any async prewarm that is still in flight
+	if (PrewarmLoadHandle.IsValid())
 	{
-		// TODO: Add On Screen Debug Message.
-		return;
+		PrewarmLoadHandle->CancelHandle();
+		PrewarmLoadHandle.Reset();
 	}
+	PendingPrewarmCount = 0;
+	PendingGrowthCount = 0;
+	PrewarmLoadSize = 0;
+	bNotifyWhenPrewarmed = false;
 
-	// Set the pooled object class to the assigned class
-	PooledObjectClass = ActorClass;
-	
-	// Set the pool size assigned 
-	PoolSize = InitialSize;
+	// Nothing can be spawned from here on, fail the queued spawns so no worker waits on them
+	DrainQueuedRequests(false);
 
-	// Expand the pool by the assigned size
-	for (int32 i = 0; i < PoolSize; ++i)
+	if (IsValid(TemplateActor))
 	{
-		ExpandPool();
+		TemplateActor->Destroy();
 	}
+	TemplateActor = nullptr;
+
+	// Actors must leave their clusters before they are destroyed with the pool
+	GetWorld()->GetTimerManager().ClearTimer(IdleClusterTimer);
+	GetWorld()->GetTimerManager().ClearTimer(ReturnDistanceTimer);
+	DissolveAllChunkClusters();
+
+	// Take this pool out of the process wide counters
+	PublishPoolCounters(0, 0);
+
+	Super::EndPlay(EndPlayReason);
 }
 
-void UObjectPoolingComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+void UObjectPoolingComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
-	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (bQueuedRequestsPending)
+	{
+		DrainQueuedRequests();
+	}
+
+	if (LifespanHeap.Num() > 0)
+	{
+		ProcessExpiredLifespans();
+	}
+
+	if (bAdaptiveSizing && PooledObjectClass)
+	{
+		TickAdaptiveSizing(DeltaTime);
+	}
+
+	if (PendingPrewarmCount > 0 || PendingGrowthCount > 0)
+	{
+		TickPrewarm();
+	}
+
+	if (PendingPredictions.Num() > 0)
+	{
+		ProcessPredictionTimeouts();
+	}
 
-	// Replicate the pool array to keep it synchronized across clients
-	DOREPLIFETIME(UObjectPoolingComponent, Pool);
+	RefreshTickEnabled();
 }
 
-void UObjectPoolingComponent::Multicast_OnPoolInitialized_Implementation()
+void UObjectPoolingComponent::RefreshTickEnabled()
 {
-	// Notify any listeners of the broadcast
-	OnPoolInitialized.Broadcast(); 
-	UE_LOG(LogTemp, Log, TEXT("Object pool has been initialized on clients."));
+	const bool bNeedsAdaptiveSizing = bAdaptiveSizing && PooledObjectClass && IsServer();
+	SetComponentTickEnabled(PendingPrewarmCount > 0 || PendingGrowthCount > 0 || LifespanHeap.Num() > 0 || PendingPredictions.Num() > 0 || bQueuedRequestsPending || bNeedsAdaptiveSizing);
 }
 
-void UObjectPoolingComponent::HandleDestroyedActor(AActor* DestroyedActor)
+TFuture<FPooledActorHandle> UObjectPoolingComponent::EnqueueSpawnRequest(const FTransform& SpawnTransform)
+{
+	FQueuedSpawnRequest Request;
+	Request.SpawnTransform = SpawnTransform;
+	TFuture<FPooledActorHandle> Future = Request.Promise.GetFuture();
+
+	QueuedSpawnRequests.Enqueue(MoveTemp(Request));
+	ScheduleQueuedRequestDrain();
+	return Future;
+}
+
+void UObjectPoolingComponent::EnqueueReturnRequest(const FPooledActorHandle& Handle)
+{
+	if (!Handle.IsSet()) return;
+
+	QueuedReturnRequests.Enqueue(Handle);
+	ScheduleQueuedRequestDrain();
+}
+
+void UObjectPoolingComponent::ScheduleQueuedRequestDrain()
 {
-	if (IsValid(DestroyedActor) && Pool.Contains(DestroyedActor))
+	// Only the first request of a batch wakes the game thread, the rest ride along with it
+	if (bQueuedRequestsPending.exchange(true))
 	{
-		ReturnObjectToPool(DestroyedActor);
+		return;
 	}
+
+	AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<UObjectPoolingComponent>(this)]()
+	{
+		UObjectPoolingComponent* Pool = WeakThis.Get();
+		if (!Pool) return;
+
+		// The tick drains the batch.  A pool that is not playing does not tick, so it fails the requests right away
+		if (Pool->HasBegunPlay())
+		{
+			Pool->SetComponentTickEnabled(true);
+		}
+		else
+		{
+			Pool->DrainQueuedRequests(false);
+		}
+	});
 }
 
-AActor* UObjectPoolingComponent::GetPooledObject()
+void UObjectPoolingComponent::DrainQueuedRequests(bool bCanSpawn)
 {
-	// Check if pool is initialized and has elements
-	if (Pool.Num() == 0)
+	OBJECTPOOL_SCOPE_CYCLE_COUNTER(STAT_ObjectPool_DrainQueuedRequests);
+
+	// Cleared before draining, so a request enqueued while draining schedules the next batch
+	bQueuedRequestsPending = false;
+
+	FPooledActorHandle Handle;
+	while (QueuedReturnRequests.Dequeue(Handle))
+	{
+		ReleaseHandle(Handle);
+	}
+
+	FQueuedSpawnRequest Request;
+	while (QueuedSpawnRequests.Dequeue(Request))
+	{
+		Request.Promise.SetValue(bCanSpawn ? SpawnPooledActorHandle(Request.SpawnTransform) : FPooledActorHandle());
+	}
+}
+
+void UObjectPoolingComponent::InitializePool(TSubclassOf<AActor> ActorClass, int32 InitialSize)
+{
+	// Only initialize the object pool on the server
+	if (!IsServer())
+	{
+		// TODO: Add On Screen Debug Message.
+		return;
+	}
+
+	if (bClientPrediction)
+	{
+		PredictionClass = ActorClass;
+	}
+
+	// Forward to the world's shared pool for the class when requested
+	if (bUseSharedPool)
 	{
-		if (GEngine)
+		if (UObjectPoolSubsystem* Subsystem = GetWorld()->GetSubsystem<UObjectPoolSubsystem>())
 		{
-			GEngine->AddOnScreenDebugMessage(1, 5.f, FColor::Emerald,
-				TEXT("Pool is empty! Did you call InitializePool?"));
+			SharedPool = Subsystem->FindOrCreatePool(ActorClass, InitialSize, this);
+			BindSharedPoolInitialized();
 		}
-		
-		UE_LOG(LogTemp, Warning, TEXT("Pool is empty! Did you call InitializePool?"));
-		return nullptr;
+		return;
 	}
+
+	// Set the pooled object class to the assigned class
+	PooledObjectClass = ActorClass;
+	CachePooledClassInterface();
 	
-	for (AActor* Actor : Pool)
+	// Later calls top the pool up, so the reserved size is the largest total asked for, not the last top-up
+	PoolSize = FMath::Max(PoolSize, GetNumPooledActors() + InitialSize);
+
+	// Expand the pool by the assigned size
+	ExpandPool(InitialSize);
+
+	FinishPoolInitialization();
+}
+
+void UObjectPoolingComponent::InitializePoolAsync(TSoftClassPtr<AActor> ActorClass, int32 InitialSize)
+{
+	// Only initialize the object pool on the server
+	if (!IsServer() || IsPrewarming())
+	{
+		return;
+	}
+
+	if (ActorClass.IsNull())
+	{
+		UE_LOG(LogObjectPool, Error, TEXT("InitializePoolAsync was called without an actor class."));
+		return;
+	}
+
+	if (InitialSize <= 0)
+	{
+		InitialSize = InitialPoolSize;
+	}
+
+	// Skip the load if the class is already in memory
+	if (ActorClass.Get())
+	{
+		OnPrewarmClassLoaded(ActorClass, InitialSize);
+		return;
+	}
+
+	PrewarmLoadSize = InitialSize;
+	PrewarmLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(ActorClass.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(this, &UObjectPoolingComponent::OnPrewarmClassLoaded, ActorClass, InitialSize));
+}
+
+void UObjectPoolingComponent::OnPrewarmClassLoaded(TSoftClassPtr<AActor> ActorClass, int32 InitialSize)
+{
+	PrewarmLoadHandle.Reset();
+
+	// Requesters that joined while the class was loading are spawned with the rest
+	InitialSize = FMath::Max(InitialSize, PrewarmLoadSize);
+	PrewarmLoadSize = 0;
+
+	UClass* LoadedClass = ActorClass.Get();
+	if (!LoadedClass)
+	{
+		UE_LOG(LogObjectPool, Error, TEXT("Failed to load the pooled actor class %s."), *ActorClass.ToString());
+		return;
+	}
+
+	if (bClientPrediction)
+	{
+		PredictionClass = LoadedClass;
+	}
+
+	// Forward to the world's shared pool for the class when requested
+	if (bUseSharedPool)
 	{
-		if (IsValid(Actor) && Actor->IsHidden())
+		if (UObjectPoolSubsystem* Subsystem = GetWorld()->GetSubsystem<UObjectPoolSubsystem>())
 		{
-			// Make the actor visible before returning it
-			Actor->SetActorHiddenInGame(false);
-			Actor->SetActorEnableCollision(true);
-			Actor->SetActorTickEnabled(true);
-			Actor->SetReplicates(true);
-			Actor->SetReplicateMovement(true);
-			return Actor;
+			SharedPool = Subsystem->FindOrCreatePool(LoadedClass, InitialSize, this, true);
+			BindSharedPoolInitialized();
 		}
+		return;
 	}
 
-	// If no inactive objects are available, consider expanding the pool if needed
-	if (bAutoExpand)  // Assume bAutoExpand is a boolean we defined earlier
+	// Set the pooled object class and pool size and let the tick spawn the actors
+	PooledObjectClass = LoadedClass;
+	CachePooledClassInterface();
+	PoolSize = FMath::Max(PoolSize, GetNumPooledActors() + PendingPrewarmCount + InitialSize);
+	PendingPrewarmCount += InitialSize;
+	bNotifyWhenPrewarmed = true;
+	ReserveSlots(InitialSize);
+
+	RefreshTickEnabled();
+}
+
+int32 UObjectPoolingComponent::GetPrewarmTargetSize() const
+{
+	if (SharedPool)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Expanding pool as no inactive objects are available."));
-		ExpandPool();
-        
-		// Return an inactive actor from the pool that was added
-		return Pool.Last(); 
+		return SharedPool->GetPrewarmTargetSize();
 	}
 
-	
-	// If auto-expansion is disabled and no object is available, return null
-	UE_LOG(LogTemp, Warning, TEXT("No available pooled objects, and pool auto-expansion is disabled."));
-	
-	return nullptr; 
+	return GetNumPooledActors() + PendingPrewarmCount + PrewarmLoadSize;
 }
 
-void UObjectPoolingComponent::ReturnObjectToPool(AActor* Actor)
+void UObjectPoolingComponent::AddToPrewarm(int32 Count)
 {
-	// Check that it is being called from the server, has been passed a valid actor, and contains a valid actor.
-	if (!GetOwner()->HasAuthority() || !Actor || !Pool.Contains(Actor)) return;
+	if (SharedPool)
+	{
+		SharedPool->AddToPrewarm(Count);
+		return;
+	}
 
-	UE_LOG(LogTemp, Log, TEXT("Returning actor to pool: %s"), *Actor->GetName());
-	
-	// Handle Actor Properties
-	Actor->SetActorHiddenInGame(true);
-	Actor->SetActorEnableCollision(false);
-	Actor->SetActorTickEnabled(false);
-	Actor->SetActorLocation(FVector::ZeroVector);
+	if (Count <= 0) return;
 
-	// Stop replicating movement when the actor is returned to the pool
-	Actor->SetReplicates(false);
-	Actor->SetReplicateMovement(false);
+	// Still loading, the count is queued with the rest once the class is in
+	if (PrewarmLoadHandle.IsValid())
+	{
+		PrewarmLoadSize += Count;
+		return;
+	}
 
-	// Check if using the lifespan timer
-	if (bUseTimerLifespan)
+	if (!bNotifyWhenPrewarmed) return;
+
+	PoolSize = FMath::Max(PoolSize, GetPrewarmTargetSize() + Count);
+	PendingPrewarmCount += Count;
+	ReserveSlots(Count);
+	RefreshTickEnabled();
+}
+
+void UObjectPoolingComponent::BindSharedPoolInitialized()
+{
+	if (!SharedPool) return;
+
+	if (SharedPool->IsPrewarming())
+	{
+		SharedPool->OnPoolInitialized.AddUniqueDynamic(this, &UObjectPoolingComponent::HandleSharedPoolInitialized);
+	}
+	else
 	{
-		GetWorld()->GetTimerManager().ClearAllTimersForObject(Actor);
+		FinishPoolInitialization();
 	}
+}
 
-	// Decrement the active objects and set the amount of inactive objects
-	ActiveObjects--;
-	InactiveObjects = Pool.Num() - ActiveObjects;
-	TotalReturnRequests++;
-	
-	// Broadcast event when the actor is returned to the pool
-	OnPooledActorReturned.Broadcast(Actor);	
+void UObjectPoolingComponent::HandleSharedPoolInitialized()
+{
+	SharedPool->OnPoolInitialized.RemoveDynamic(this, &UObjectPoolingComponent::HandleSharedPoolInitialized);
+	FinishPoolInitialization();
 }
 
-AActor* UObjectPoolingComponent::SpawnPooledActor(const FTransform& SpawnTransform)
+void UObjectPoolingComponent::TickPrewarm()
 {
-	if (!IsServer()) return nullptr; // Only the server should spawn objects
-	
-	TotalSpawnRequests++;
+	const double StartTime = FPlatformTime::Seconds();
+	const double TimeBudget = PrewarmMillisecondsPerFrame / 1000.0;
 
-	AActor* PooledActor = GetPooledObject();
-	if (PooledActor)
+	// Spawn until either the actor budget or the time budget for this frame is used up
+	for (int32 Spawned = 0; (PendingPrewarmCount > 0 || PendingGrowthCount > 0) && Spawned < PrewarmActorsPerFrame; ++Spawned)
 	{
-		// Check if the actor implements UPooledActorInterface
-		// Reset the actor before being reused again
-		if (PooledActor->GetClass()->ImplementsInterface(UPooledActorInterface::StaticClass()))
+		AddPooledActor();
+
+		// The initialization prewarm goes first, so its notification is never held back by background growth
+		if (PendingPrewarmCount > 0)
 		{
-			IPooledActorInterface::Execute_ResetPooledActor(PooledActor);
+			PendingPrewarmCount--;
+		}
+		else
+		{
+			PendingGrowthCount--;
 		}
-		
-		// Set location and rotation
-		PooledActor->SetActorTransform(SpawnTransform);
-
-		// Make the actor visible and enable interaction
-		PooledActor->SetActorHiddenInGame(false);
-		PooledActor->SetActorEnableCollision(true);
-		PooledActor->SetActorTickEnabled(true);
 
-		if (!bUseTimerLifespan)
+		if (TimeBudget > 0.0 && FPlatformTime::Seconds() - StartTime >= TimeBudget)
 		{
-			PooledActor->OnDestroyed.AddDynamic(this, &UObjectPoolingComponent::HandleDestroyedActor);
+			break;
 		}
+	}
 
-		// Notify clients about the activation
-		PooledActor->SetReplicates(true);
-		PooledActor->SetReplicateMovement(true);
+	// Only an initialization prewarm notifies listeners
+	if (PendingPrewarmCount == 0 && bNotifyWhenPrewarmed)
+	{
+		bNotifyWhenPrewarmed = false;
+		FinishPoolInitialization();
+	}
+}
 
-		TotalObjectsCreated++;
-		ActiveObjects++;
-		InactiveObjects = Pool.Num() - ActiveObjects;
+void UObjectPoolingComponent::FinishPoolInitialization()
+{
+	// Multicast also runs on the server so listeners there are notified as well
+	Multicast_OnPoolInitialized();
 
-		// Update peak usage if active objects exceed previous peak
-		if (ActiveObjects > PeakUsage)
-		{
-			PeakUsage = ActiveObjects;
-		}
+	RefreshTickEnabled();
+}
+
+void UObjectPoolingComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// Only the compact counters are replicated.  Clients never use the pool array and resending it on every expansion is costly.
+	DOREPLIFETIME(UObjectPoolingComponent, ActiveObjects);
+	DOREPLIFETIME(UObjectPoolingComponent, InactiveObjects);
+
+	// Prediction state only matters to the client that owns the component
+	DOREPLIFETIME_CONDITION(UObjectPoolingComponent, PredictionClass, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(UObjectPoolingComponent, PredictionHandoffs, COND_OwnerOnly);
+}
+
+void UObjectPoolingComponent::Multicast_OnPoolInitialized_Implementation()
+{
+	// Notify any listeners of the broadcast
+	OnPoolInitialized.Broadcast(); 
+	UE_LOG(LogObjectPool, Log, TEXT("Object pool has been initialized on clients."));
+}
+
+void UObjectPoolingComponent::HandleDestroyedActor(AActor* DestroyedActor)
+{
+	// A destroyed actor cannot be reused, so drop its slot instead of returning it
+	const int32 SlotIndex = FindSlotIndex(DestroyedActor);
+	if (SlotIndex != INDEX_NONE)
+	{
+		RemoveDeadSlot(SlotIndex);
+	}
+}
+
+void UObjectPoolingComponent::RemoveDeadSlot(int32 SlotIndex)
+{
+	DissolveChunkCluster(SlotIndex);
+
+	if (SlotInUse[SlotIndex])
+	{
+		SlotInUse[SlotIndex] = false;
+		ActiveObjects--;
+	}
+	else
+	{
+		RemoveFreeSlot(SlotIndex);
+	}
 
-		// Will use the timer based on the actor lifespan to return the actor back to the pool.
-		if (bUseTimerLifespan)
+	SlotGenerations[SlotIndex]++;
+	SlotExpiryTimes[SlotIndex] = 0.0;
+	SlotRequesters[SlotIndex].Reset();
+	SlotSleepStates[SlotIndex].Mode = EPooledActorSleepMode::None;
+	SlotSleepStates[SlotIndex].Components.Reset();
+	if (SlotLookup.Remove(Pool[SlotIndex]) == 0)
+	{
+		// Garbage collection already nulled the actor, so the entry can only be found by its slot
+		for (TMap<const AActor*, int32>::TIterator It = SlotLookup.CreateIterator(); It; ++It)
 		{
-			GetWorld()->GetTimerManager().SetTimerForNextTick([this, PooledActor]()
+			if (It.Value() == SlotIndex)
 			{
-				/* Timer handle used to manage the lifespan of the actor. */
-				FTimerHandle LifespanTimerHandle;
-				GetWorld()->GetTimerManager().SetTimer(LifespanTimerHandle, FTimerDelegate::CreateUObject(this, &UObjectPoolingComponent::ReturnObjectToPool, PooledActor),
-					ActorLifespan,
-					false
-					);
+				It.RemoveCurrent();
+				break;
 			}
-			);
-		}
-		else
-		{
-			// This will cause the actor to destroy itself and then force the system to create a new spot in memory at the end of the array.
-			// This works great if you do not want to manually reset data for reusing the actor.
-			PooledActor->SetLifeSpan(ActorLifespan);
 		}
-		
-		// Broadcast event when pooled actor is spawned
-		OnPooledActorSpawned.Broadcast(PooledActor);
-		
-		return PooledActor;
 	}
+	Pool[SlotIndex] = nullptr;
+	DeadSlots.Push(SlotIndex);
 
-	// Return null if no actor is available
-	return nullptr; 
+	UpdateInactiveObjects();
 }
 
-void UObjectPoolingComponent::ExpandPool()
+void UObjectPoolingComponent::UpdateInactiveObjects()
 {
-	// Check that there if a valid context object and valid class assigned to be pooled
-	if (!IsServer() || !GetWorld() || !PooledObjectClass) return;
+	InactiveObjects = Pool.Num() - DeadSlots.Num() - ActiveObjects;
+	PublishPoolCounters(ActiveObjects, InactiveObjects);
+}
 
-	AActor* NewActor = GetWorld()->SpawnActor<AActor>(PooledObjectClass);
-	if (IsValid(NewActor))
+void UObjectPoolingComponent::PublishPoolCounters(int32 Active, int32 Inactive)
+{
+	using namespace ObjectPoolCounters;
+
+	// Apply this pool's change to the totals
+	TotalActiveObjects += Active - ReportedActiveObjects;
+	TotalInactiveObjects += Inactive - ReportedInactiveObjects;
+	PeakActiveObjects = FMath::Max(PeakActiveObjects, TotalActiveObjects);
+	ReportedActiveObjects = Active;
+	ReportedInactiveObjects = Inactive;
+
+	TRACE_COUNTER_SET(ObjectPool_ActiveObjects, TotalActiveObjects);
+	TRACE_COUNTER_SET(ObjectPool_InactiveObjects, TotalInactiveObjects);
+	TRACE_COUNTER_SET(ObjectPool_PeakUsage, PeakActiveObjects);
+
+	CSV_CUSTOM_STAT(ObjectPool, ActiveObjects, TotalActiveObjects, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(ObjectPool, InactiveObjects, TotalInactiveObjects, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(ObjectPool, PeakUsage, PeakActiveObjects, ECsvCustomStatOp::Set);
+}
+
+int32 UObjectPoolingComponent::FindSlotIndex(const AActor* Actor) const
+{
+	const int32* SlotIndex = SlotLookup.Find(Actor);
+	return SlotIndex ? *SlotIndex : INDEX_NONE;
+}
+
+AActor* UObjectPoolingComponent::GetPooledObject()
+{
+	if (SharedPool)
 	{
-		// Handle Actor Properties
-		NewActor->SetActorHiddenInGame(true);
-		NewActor->SetActorEnableCollision(false);
-		NewActor->SetActorTickEnabled(false);
+		return SharedPool->GetPooledObject();
+	}
 
-		// Set replication on the new actor
-		NewActor->SetReplicates(true);
-		NewActor->SetReplicateMovement(false);
+	int32 SlotIndex;
+	AActor* Actor = AcquirePooledActor(SlotIndex);
+	if (Actor)
+	{
+		// Activate the actor where it is, callers place it themselves
+		ActivatePooledActor(Actor, SlotIndex, nullptr);
+	}
+	return Actor;
+}
 
-		// Add the actor to the pool
-		Pool.Add(NewActor);
+AActor* UObjectPoolingComponent::AcquirePooledActor(int32& OutSlotIndex, const FVector* NearLocation, const TBitArray<>* EvictionExcludedSlots)
+{
+	OBJECTPOOL_SCOPE_CYCLE_COUNTER(STAT_ObjectPool_GetPooledObject);
 
-		// Recalculate the inactive objects and increment objects created and amount of expansions
-		TotalObjectsCreated++;
-		TotalPoolExpansions++;
-		InactiveObjects = Pool.Num() - ActiveObjects;
+#if !UE_BUILD_SHIPPING
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+#endif
+	const bool bHadFreeSlot = FreeSlots.Num() > 0;
+
+	AActor* Actor = AcquireFreeSlot(OutSlotIndex, NearLocation, EvictionExcludedSlots);
+
+	if (Actor && bHadFreeSlot)
+	{
+		TotalPoolHits++;
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to spawn actor for the pool."));
+		TotalPoolMisses++;
+	}
+
+	// Only the dashboard reads the histogram, and it is compiled out of shipping builds
+#if !UE_BUILD_SHIPPING
+	const uint64 ElapsedNanoseconds = static_cast<uint64>(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1e9);
+	AcquireLatencyBuckets[FMath::Min<int32>(FMath::FloorLog2_64(ElapsedNanoseconds | 1), NumAcquireLatencyBuckets - 1)]++;
+#endif
+
+	return Actor;
+}
+
+float UObjectPoolingComponent::GetAcquireLatencyPercentile(float Percentile) const
+{
+#if UE_BUILD_SHIPPING
+	return 0.f;
+#else
+	uint64 TotalAcquires = 0;
+	for (const uint32 Count : AcquireLatencyBuckets)
+	{
+		TotalAcquires += Count;
 	}
+	if (TotalAcquires == 0) return 0.f;
+
+	const uint64 TargetCount = FMath::Max<uint64>(1, FMath::CeilToInt64(TotalAcquires * FMath::Clamp(Percentile, 0.f, 1.f)));
+	uint64 RunningCount = 0;
+	for (int32 Bucket = 0; Bucket < NumAcquireLatencyBuckets; ++Bucket)
+	{
+		RunningCount += AcquireLatencyBuckets[Bucket];
+		if (RunningCount >= TargetCount)
+		{
+			return static_cast<float>(uint64(1) << (Bucket + 1)) / 1000.f;
+		}
+	}
+	return static_cast<float>(uint64(1) << NumAcquireLatencyBuckets) / 1000.f;
+#endif
 }
 
+AActor* UObjectPoolingComponent::AcquireFreeSlot(int32& OutSlotIndex, const FVector* NearLocation, const TBitArray<>* EvictionExcludedSlots)
+{
+	OutSlotIndex = INDEX_NONE;
+
+	// Check if pool is initialized and has elements
+	if (Pool.Num() == 0)
+	{
+		if (ShouldLogPoolWarning())
+		{
+#if !UE_BUILD_SHIPPING
+			if (GEngine)
+			{
+				GEngine->AddOnScreenDebugMessage(1, 5.f, FColor::Emerald,
+					TEXT("Pool is empty! Did you call InitializePool?"));
+			}
+#endif
+			
+			UE_LOG(LogObjectPool, Warning, TEXT("Pool is empty! Did you call InitializePool?"));
+		}
+		return nullptr;
+	}
+	
+	// Pop free slots until a live actor is found.  Slots whose actor was destroyed are dropped from the free list.
+	while (FreeSlots.Num() > 0 || bAutoExpand)
+	{
+		// If no inactive objects are available, consider expanding the pool if needed
+		if (FreeSlots.Num() == 0)
+		{
+			const int32 GrowthCount = GetGrowthCount();
+
+			// Nothing left to grow by, for example at MaxPoolSize.  Leave it to the eviction policy
+			if (GrowthCount <= 0)
+			{
+				break;
+			}
+
+			// Finish the growth in the background and drop this request instead of stalling the frame
+			if (bDeferredOverflow)
+			{
+				if (PendingPrewarmCount == 0 && PendingGrowthCount == 0)
+				{
+					UE_CLOG(ShouldLogPoolWarning(), LogObjectPool, Warning, TEXT("Pool is exhausted, growing by %d actors in the background."), GrowthCount);
+					PendingGrowthCount = GrowthCount;
+					RefreshTickEnabled();
+				}
+				return nullptr;
+			}
+
+			UE_CLOG(ShouldLogPoolWarning(), LogObjectPool, Warning, TEXT("Expanding pool by %d actors as no inactive objects are available."), GrowthCount);
+			ExpandPool(GrowthCount);
+
+			// Expansion failed, there is nothing left to hand out
+			if (FreeSlots.Num() == 0)
+			{
+				break;
+			}
+		}
+
+		const int32 SlotIndex = bSpatialReuse && NearLocation ? PopNearestFreeSlot(*NearLocation) : PopFreeSlot();
+		AActor* Actor = Pool[SlotIndex];
+		if (!IsValid(Actor))
+		{
+			// Destroyed or collected without the pool hearing about it, recycle the slot instead of leaking it
+			RemoveDeadSlot(SlotIndex);
+			continue;
+		}
+
+		// An active actor changes its references, so it cannot stay in a cluster.  The free list is LIFO, so hot slots are rarely clustered
+		if (bClusterIdleActors)
+		{
+			DissolveChunkCluster(SlotIndex);
+		}
+
+		// The caller activates the actor, so its state is only touched once per reuse
+		SlotInUse[SlotIndex] = true;
+		OutSlotIndex = SlotIndex;
+		return Actor;
+	}
+
+	// Recycle an active actor rather than drop the spawn.  The victim's slot is the only free one, so the retry takes it
+	if (EvictionPolicy != EPooledEvictionPolicy::None && EvictActor(EvictionExcludedSlots))
+	{
+		return AcquireFreeSlot(OutSlotIndex, NearLocation, EvictionExcludedSlots);
+	}
+
+	// If auto-expansion is disabled or failed and no object is available, return null
+	UE_CLOG(ShouldLogPoolWarning(), LogObjectPool, Warning, TEXT("No available pooled objects, and pool auto-expansion is disabled."));
+	
+	return nullptr; 
+}
+
+void UObjectPoolingComponent::ReturnObjectToPool(AActor* Actor)
+{
+	OBJECTPOOL_SCOPE_CYCLE_COUNTER(STAT_ObjectPool_ReturnObjectToPool);
+
+	// Only count returns the shared pool accepted, so double returns and foreign actors do not skew the statistics
+	if (SharedPool)
+	{
+		TotalReturnRequests += SharedPool->ReturnObjectToPoolInternal(Actor) ? 1 : 0;
+		return;
+	}
+
+	ReturnObjectToPoolInternal(Actor);
+}
+
+bool UObjectPoolingComponent::ReturnObjectToPoolInternal(AActor* Actor)
+{
+	if (!IsServer() || !Actor) return false;
+
+	const int32 SlotIndex = FindSlotIndex(Actor);
+	if (SlotIndex == INDEX_NONE) return false;
+
+	return ReturnSlotToPool(SlotIndex);
+}
+
+bool UObjectPoolingComponent::ReturnSlotToPool(int32 SlotIndex)
+{
+	if (!ReleaseSlot(SlotIndex)) return false;
+
+	// Decrement the active objects and set the amount of inactive objects
+	ActiveObjects--;
+	UpdateInactiveObjects();
+	TotalReturnRequests++;
+	
+	// Broadcast event when the actor is returned to the pool, including to the component that requested it from a shared pool
+	AActor* Actor = Pool[SlotIndex];
+	OnPooledActorReturned.Broadcast(Actor);
+	if (UObjectPoolingComponent* Requester = SlotRequesters[SlotIndex].Get())
+	{
+		Requester->OnPooledActorReturned.Broadcast(Actor);
+	}
+	SlotRequesters[SlotIndex].Reset();
+	return true;
+}
+
+void UObjectPoolingComponent::ReturnObjectsToPool(const TArray<AActor*>& Actors)
+{
+	OBJECTPOOL_SCOPE_CYCLE_COUNTER(STAT_ObjectPool_ReturnObjectsToPool);
+
+	if (SharedPool)
+	{
+		TotalReturnRequests += SharedPool->ReturnObjectsToPoolInternal(Actors);
+		return;
+	}
+
+	ReturnObjectsToPoolInternal(Actors);
+}
+
+int32 UObjectPoolingComponent::ReturnObjectsToPoolInternal(const TArray<AActor*>& Actors)
+{
+	TArray<AActor*> ReturnedActors;
+	ReturnedActors.Reserve(Actors.Num());
+
+	// Group the returned actors by requester so each one gets a single batch event
+	TMap<UObjectPoolingComponent*, TArray<AActor*>> RequesterBatches;
+
+	for (AActor* Actor : Actors)
+	{
+		const int32 SlotIndex = ReleasePooledActor(Actor);
+		if (SlotIndex == INDEX_NONE) continue;
+
+		ReturnedActors.Add(Actor);
+		if (UObjectPoolingComponent* Requester = SlotRequesters[SlotIndex].Get())
+		{
+			RequesterBatches.FindOrAdd(Requester).Add(Actor);
+		}
+		SlotRequesters[SlotIndex].Reset();
+	}
+
+	if (ReturnedActors.Num() == 0) return 0;
+
+	// Update the statistics once for the whole batch
+	ActiveObjects -= ReturnedActors.Num();
+	UpdateInactiveObjects();
+	TotalReturnRequests += ReturnedActors.Num();
+
+	OnPooledActorsReturned.Broadcast(ReturnedActors);
+	for (const TPair<UObjectPoolingComponent*, TArray<AActor*>>& Batch : RequesterBatches)
+	{
+		Batch.Key->OnPooledActorsReturned.Broadcast(Batch.Value);
+	}
+	return ReturnedActors.Num();
+}
+
+int32 UObjectPoolingComponent::ReleasePooledActor(AActor* Actor)
+{
+	// Check that it is being called from the server, has been passed a valid actor, and contains a valid actor.
+	if (!IsServer() || !Actor) return INDEX_NONE;
+
+	const int32 SlotIndex = FindSlotIndex(Actor);
+	if (SlotIndex == INDEX_NONE) return INDEX_NONE;
+
+	return ReleaseSlot(SlotIndex) ? SlotIndex : INDEX_NONE;
+}
+
+bool UObjectPoolingComponent::ReleaseSlot(int32 SlotIndex)
+{
+	// Ignore double returns so they cannot skew the active object count
+	if (!SlotInUse[SlotIndex])
+	{
+		UE_LOG(LogObjectPool, Verbose, TEXT("Ignoring return of an actor that is already in the pool."));
+		return false;
+	}
+
+	// The spatial cell is where the actor was returned, not where it is parked
+	const FVector ReturnLocation = bSpatialReuse ? Pool[SlotIndex]->GetActorLocation() : FVector::ZeroVector;
+
+	DeactivatePooledActor(Pool[SlotIndex], SlotIndex);
+
+	// Any lifespan still in the heap for this slot is now stale
+	SlotExpiryTimes[SlotIndex] = 0.0;
+
+	// Hand the slot back to the free list
+	SlotInUse[SlotIndex] = false;
+	SlotGenerations[SlotIndex]++;
+	PushFreeSlot(SlotIndex, ReturnLocation);
+
+	if (bClusterIdleActors && ChunkLastUseTimes.IsValidIndex(SlotIndex / IdleClusterSize))
+	{
+		ChunkLastUseTimes[SlotIndex / IdleClusterSize] = GetWorld()->GetTimeSeconds();
+	}
+
+	return true;
+}
+
+AActor* UObjectPoolingComponent::SpawnPooledActor(const FTransform& SpawnTransform)
+{
+	if (SharedPool)
+	{
+		TotalSpawnRequests++;
+		return SharedPool->SpawnPooledActorInternal(SpawnTransform, this);
+	}
+
+	return SpawnPooledActorInternal(SpawnTransform, nullptr);
+}
+
+FPooledActorHandle UObjectPoolingComponent::SpawnPooledActorHandle(const FTransform& SpawnTransform)
+{
+	FPooledActorHandle Handle;
+	if (SharedPool)
+	{
+		TotalSpawnRequests++;
+		SharedPool->SpawnPooledActorInternal(SpawnTransform, this, &Handle);
+	}
+	else
+	{
+		SpawnPooledActorInternal(SpawnTransform, nullptr, &Handle);
+	}
+	return Handle;
+}
+
+AActor* UObjectPoolingComponent::ResolveHandle(const FPooledActorHandle& Handle) const
+{
+	if (SharedPool)
+	{
+		return SharedPool->ResolveHandle(Handle);
+	}
+
+	// A returned or destroyed actor bumped its slot's generation, so any handle to it no longer matches
+	return SlotGenerations.IsValidIndex(Handle.SlotIndex) && SlotInUse[Handle.SlotIndex] && SlotGenerations[Handle.SlotIndex] == Handle.Generation
+		? Pool[Handle.SlotIndex]
+		: nullptr;
+}
+
+bool UObjectPoolingComponent::ReleaseHandle(const FPooledActorHandle& Handle)
+{
+	OBJECTPOOL_SCOPE_CYCLE_COUNTER(STAT_ObjectPool_ReturnObjectToPool);
+
+	if (SharedPool)
+	{
+		const bool bReleased = SharedPool->ReleaseHandle(Handle);
+		TotalReturnRequests += bReleased ? 1 : 0;
+		return bReleased;
+	}
+
+	if (!IsServer() || !ResolveHandle(Handle))
+	{
+		UE_CLOG(Handle.IsSet(), LogObjectPool, Verbose, TEXT("Ignoring release of a stale pooled actor handle."));
+		return false;
+	}
+
+	return ReturnSlotToPool(Handle.SlotIndex);
+}
+
+FPooledActorHandle UObjectPoolingComponent::GetActorHandle(const AActor* Actor) const
+{
+	if (SharedPool)
+	{
+		return SharedPool->GetActorHandle(Actor);
+	}
+
+	FPooledActorHandle Handle;
+	const int32 SlotIndex = FindSlotIndex(Actor);
+	if (SlotIndex != INDEX_NONE && SlotInUse[SlotIndex])
+	{
+		Handle.SlotIndex = SlotIndex;
+		Handle.Generation = SlotGenerations[SlotIndex];
+	}
+	return Handle;
+}
+
+AActor* UObjectPoolingComponent::SpawnPooledActorInternal(const FTransform& SpawnTransform, UObjectPoolingComponent* Requester, FPooledActorHandle* OutHandle)
+{
+	OBJECTPOOL_SCOPE_CYCLE_COUNTER(STAT_ObjectPool_SpawnPooledActor);
+
+	if (!IsServer()) return nullptr; // Only the server should spawn objects
+	
+	TotalSpawnRequests++;
+
+	int32 SlotIndex;
+	const FVector SpawnLocation = SpawnTransform.GetLocation();
+	AActor* PooledActor = AcquirePooledActor(SlotIndex, &SpawnLocation);
+	if (PooledActor)
+	{
+		PrepareSpawnedActor(PooledActor, SlotIndex, SpawnTransform, Requester);
+		RecordSpawnedActors(1);
+
+		if (OutHandle)
+		{
+			OutHandle->SlotIndex = SlotIndex;
+			OutHandle->Generation = SlotGenerations[SlotIndex];
+		}
+
+		// Will use the pool lifespan heap based on the actor lifespan to return the actor back to the pool.
+		ApplySpawnLifespans(MakeArrayView(&SlotIndex, 1));
+		
+		// Broadcast event when pooled actor is spawned, including to the component that requested it from a shared pool
+		OnPooledActorSpawned.Broadcast(PooledActor);
+		if (Requester)
+		{
+			Requester->OnPooledActorSpawned.Broadcast(PooledActor);
+		}
+		
+		return PooledActor;
+	}
+
+	// Return null if no actor is available
+	return nullptr; 
+}
+
+AActor* UObjectPoolingComponent::SpawnPredictedActor(const FTransform& SpawnTransform, int32& OutPredictionId)
+{
+	OutPredictionId = INDEX_NONE;
+
+	// The server and standalone games spawn the real actor straight away
+	if (GetOwner()->HasAuthority())
+	{
+		return SpawnPooledActor(SpawnTransform);
+	}
+
+	if (!bClientPrediction)
+	{
+		UE_CLOG(ShouldLogPoolWarning(), LogObjectPool, Warning, TEXT("SpawnPredictedActor was called on a client without bClientPrediction."));
+		return nullptr;
+	}
+
+	InitializeMirrorPool();
+	if (!MirrorPool)
+	{
+		return nullptr;
+	}
+
+	AActor* PredictedActor = MirrorPool->SpawnPooledActor(SpawnTransform);
+	if (!PredictedActor)
+	{
+		return nullptr;
+	}
+
+	OutPredictionId = NextPredictionId;
+	NextPredictionId = NextPredictionId == MAX_int32 ? 1 : NextPredictionId + 1;
+
+	PendingPredictions.Add({ OutPredictionId, PredictedActor, GetWorld()->GetTimeSeconds() + PredictionTimeout });
+	RefreshTickEnabled();
+
+	return PredictedActor;
+}
+
+AActor* UObjectPoolingComponent::SpawnPooledActorForPrediction(const FTransform& SpawnTransform, int32 PredictionId)
+{
+	if (!IsServer()) return nullptr;
+
+	AActor* PooledActor = SpawnPooledActor(SpawnTransform);
+	if (PooledActor && PredictionId != INDEX_NONE)
+	{
+		// Only the latest handoffs are kept, older predictions have long been reconciled or timed out
+		constexpr int32 MaxPredictionHandoffs = 16;
+		if (PredictionHandoffs.Num() >= MaxPredictionHandoffs)
+		{
+			PredictionHandoffs.RemoveAt(0, 1, EAllowShrinking::No);
+		}
+		PredictionHandoffs.Add({ PredictionId, PooledActor });
+	}
+	return PooledActor;
+}
+
+void UObjectPoolingComponent::InitializeMirrorPool()
+{
+	if (MirrorPool || GetOwner()->HasAuthority() || !bClientPrediction)
+	{
+		return;
+	}
+
+	TSubclassOf<AActor> MirrorClass = PredictedActorClass ? PredictedActorClass : PredictionClass;
+	if (!MirrorClass)
+	{
+		UE_CLOG(ShouldLogPoolWarning(), LogObjectPool, Warning, TEXT("The mirror pool has no class yet, the server has not initialized its pool."));
+		return;
+	}
+
+	// A plain local component on the same owner.  It reuses the whole pool pipeline without replicating anything
+	MirrorPool = NewObject<UObjectPoolingComponent>(GetOwner(), MakeUniqueObjectName(GetOwner(), UObjectPoolingComponent::StaticClass(), TEXT("MirrorPool")));
+	MirrorPool->CopyPoolSettingsFrom(this);
+	MirrorPool->bLocalOnly = true;
+	MirrorPool->bUseSharedPool = false;
+	MirrorPool->bClientPrediction = false;
+	MirrorPool->bAutoExpand = true;
+
+	// Predicted actors go back only through reconciliation or the timeout, never through a lifespan of their own
+	MirrorPool->bUseTimerLifespan = true;
+	MirrorPool->ActorLifespan = 0.f;
+	MirrorPool->SetIsReplicated(false);
+	MirrorPool->RegisterComponent();
+	MirrorPool->InitializePool(MirrorClass, MirrorPoolSize);
+}
+
+void UObjectPoolingComponent::OnRep_PredictionHandoffs()
+{
+	for (const FPooledPredictionHandoff& Handoff : PredictionHandoffs)
+	{
+		// Unresolved actors trigger another notify once their channel opens
+		if (!Handoff.Actor)
+		{
+			continue;
+		}
+
+		const int32 PendingIndex = PendingPredictions.IndexOfByPredicate([&Handoff](const FPendingPrediction& Pending)
+		{
+			return Pending.PredictionId == Handoff.PredictionId;
+		});
+
+		if (PendingIndex != INDEX_NONE)
+		{
+			ReconcilePrediction(PendingIndex, Handoff.Actor);
+		}
+	}
+}
+
+void UObjectPoolingComponent::ReconcilePrediction(int32 PendingIndex, AActor* AuthoritativeActor)
+{
+	AActor* PredictedActor = PendingPredictions[PendingIndex].Actor.Get();
+	PendingPredictions.RemoveAt(PendingIndex, 1, EAllowShrinking::No);
+
+	// Listeners can carry state over to the authoritative actor before the predicted one goes back to the mirror pool
+	OnPredictedActorReconciled.Broadcast(PredictedActor, AuthoritativeActor);
+
+	if (PredictedActor && MirrorPool)
+	{
+		MirrorPool->ReturnObjectToPool(PredictedActor);
+	}
+}
+
+void UObjectPoolingComponent::ProcessPredictionTimeouts()
+{
+	// Pending predictions are added in order with the same timeout, so the expired ones are at the front
+	const double Now = GetWorld()->GetTimeSeconds();
+	while (PendingPredictions.Num() > 0 && PendingPredictions[0].ExpiryTime <= Now)
+	{
+		UE_LOG(LogObjectPool, Verbose, TEXT("Prediction %d was not confirmed by the server in time."), PendingPredictions[0].PredictionId);
+		ReconcilePrediction(0, nullptr);
+	}
+}
+
+int32 UObjectPoolingComponent::SpawnPooledActors(const TArray<FTransform>& SpawnTransforms, TArray<AActor*>& OutActors)
+{
+	if (SharedPool)
+	{
+		TotalSpawnRequests += SpawnTransforms.Num();
+		return SharedPool->SpawnPooledActorsInternal(SpawnTransforms, OutActors, this);
+	}
+
+	return SpawnPooledActorsInternal(SpawnTransforms, OutActors, nullptr);
+}
+
+int32 UObjectPoolingComponent::SpawnPooledActorsInternal(const TArray<FTransform>& SpawnTransforms, TArray<AActor*>& OutActors, UObjectPoolingComponent* Requester)
+{
+	OBJECTPOOL_SCOPE_CYCLE_COUNTER(STAT_ObjectPool_SpawnPooledActors);
+
+	OutActors.Reset();
+
+	// Only the server should spawn objects
+	if (!IsServer() || SpawnTransforms.Num() == 0) return 0;
+
+	TotalSpawnRequests += SpawnTransforms.Num();
+
+	OutActors.Reserve(SpawnTransforms.Num());
+	TArray<int32, TInlineAllocator<64>> SpawnedSlots;
+	SpawnedSlots.Reserve(SpawnTransforms.Num());
+
+	// Slots handed out by this batch, so eviction cannot take one back and hand it out twice
+	TBitArray<> BatchSlots;
+	const bool bTrackBatchSlots = EvictionPolicy != EPooledEvictionPolicy::None;
+
+	// Pop and activate every actor in one pass, stopping early if the pool runs dry
+	for (const FTransform& SpawnTransform : SpawnTransforms)
+	{
+		int32 SlotIndex;
+		const FVector SpawnLocation = SpawnTransform.GetLocation();
+		AActor* PooledActor = AcquirePooledActor(SlotIndex, &SpawnLocation, bTrackBatchSlots ? &BatchSlots : nullptr);
+		if (!PooledActor)
+		{
+			break;
+		}
+
+		if (bTrackBatchSlots)
+		{
+			if (SlotIndex >= BatchSlots.Num())
+			{
+				BatchSlots.Add(false, Pool.Num() - BatchSlots.Num());
+			}
+			BatchSlots[SlotIndex] = true;
+		}
+
+		PrepareSpawnedActor(PooledActor, SlotIndex, SpawnTransform, Requester);
+		SpawnedSlots.Add(SlotIndex);
+		OutActors.Add(PooledActor);
+	}
+
+	if (OutActors.Num() > 0)
+	{
+		// Statistics, lifespans and delegates are handled once for the whole batch
+		RecordSpawnedActors(OutActors.Num());
+		ApplySpawnLifespans(SpawnedSlots);
+
+		OnPooledActorsSpawned.Broadcast(OutActors);
+		if (Requester)
+		{
+			Requester->OnPooledActorsSpawned.Broadcast(OutActors);
+		}
+	}
+
+	return OutActors.Num();
+}
+
+void UObjectPoolingComponent::PrepareSpawnedActor(AActor* PooledActor, int32 SlotIndex, const FTransform& SpawnTransform, UObjectPoolingComponent* Requester)
+{
+	ActivatePooledActor(PooledActor, SlotIndex, &SpawnTransform);
+	SlotRequesters[SlotIndex] = Requester;
+}
+
+void UObjectPoolingComponent::ActivatePooledActor(AActor* Actor, int32 SlotIndex, const FTransform* SpawnTransform)
+{
+	// Bring back the physics and render state first so the reset and activation see a complete actor
+	if (SlotSleepStates[SlotIndex].Mode != EPooledActorSleepMode::None)
+	{
+		WakePooledActor(Actor, SlotIndex, SpawnTransform);
+	}
+
+	bool bHandledByActor = false;
+	if (InterfaceDispatch != EPooledInterfaceDispatch::None)
+	{
+		// Reset the actor before being reused again
+		{
+			OBJECTPOOL_SCOPE_CYCLE_COUNTER(STAT_ObjectPool_ResetPooledActor);
+			if (IPooledActorInterface* NativeInterface = GetNativeInterface(Actor))
+			{
+				NativeInterface->ResetPooledActor_Implementation();
+			}
+			else
+			{
+				IPooledActorInterface::Execute_ResetPooledActor(Actor);
+			}
+		}
+
+		// Give the actor a chance to take its own fast path
+		const FTransform& ActivationTransform = SpawnTransform ? *SpawnTransform : Actor->GetActorTransform();
+		if (IPooledActorInterface* NativeInterface = GetNativeInterface(Actor))
+		{
+			bHandledByActor = NativeInterface->ActivatePooledActor_Implementation(ActivationTransform);
+		}
+		else
+		{
+			bHandledByActor = IPooledActorInterface::Execute_ActivatePooledActor(Actor, ActivationTransform);
+		}
+	}
+
+	if (!bHandledByActor)
+	{
+		// Set location and rotation as a teleport, skipping the move when the actor is already in place
+		if (SpawnTransform && !Actor->GetActorTransform().Equals(*SpawnTransform))
+		{
+			Actor->SetActorTransform(*SpawnTransform, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+
+		// Make the actor visible and enable interaction
+		Actor->SetActorHiddenInGame(false);
+		Actor->SetActorEnableCollision(true);
+		Actor->SetActorTickEnabled(true);
+	}
+
+	// Notify clients about the activation
+	SetActorReplicationActive(Actor, true);
+
+	if (EvictionPolicy == EPooledEvictionPolicy::OldestFirst || EvictionPolicy == EPooledEvictionPolicy::LowestPriority)
+	{
+		PushEvictionCandidate(Actor, SlotIndex);
+	}
+}
+
+void UObjectPoolingComponent::PushEvictionCandidate(AActor* Actor, int32 SlotIndex)
+{
+	// Stale entries are normally dropped as they reach the top.  Sweep them out if returns outpace evictions for long enough
+	if (EvictionHeap.Num() > Pool.Num() * 2 + 64)
+	{
+		EvictionHeap.RemoveAllSwap([this](const FPooledEvictionEntry& Entry) { return !IsEvictionEntryValid(Entry); }, EAllowShrinking::No);
+		EvictionHeap.Heapify();
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	double Key = Now;
+	if (EvictionPolicy == EPooledEvictionPolicy::LowestPriority)
+	{
+		if (IPooledActorInterface* NativeInterface = GetNativeInterface(Actor))
+		{
+			Key = NativeInterface->GetPooledActorEvictionPriority_Implementation();
+		}
+		else if (InterfaceDispatch == EPooledInterfaceDispatch::Reflected)
+		{
+			Key = IPooledActorInterface::Execute_GetPooledActorEvictionPriority(Actor);
+		}
+		else
+		{
+			Key = 0.0;
+		}
+	}
+
+	EvictionHeap.HeapPush({ Key, Now, SlotIndex, SlotGenerations[SlotIndex] });
+}
+
+void UObjectPoolingComponent::RebuildEvictionHeapByDistance()
+{
+	TArray<FVector> ViewerLocations;
+	GetViewerLocations(ViewerLocations);
+
+	// Keyed by negated distance, so the farthest actor is on top of the min-heap
+	EvictionHeap.Reset();
+	for (TConstSetBitIterator<> It(SlotInUse); It; ++It)
+	{
+		const AActor* Actor = Pool[It.GetIndex()];
+		if (!IsValid(Actor)) continue;
+
+		double NearestDistanceSquared = ViewerLocations.Num() > 0 ? MAX_dbl : 0.0;
+		for (const FVector& ViewerLocation : ViewerLocations)
+		{
+			NearestDistanceSquared = FMath::Min(NearestDistanceSquared, FVector::DistSquared(Actor->GetActorLocation(), ViewerLocation));
+		}
+		EvictionHeap.Add({ -NearestDistanceSquared, 0.0, It.GetIndex(), SlotGenerations[It.GetIndex()] });
+	}
+	EvictionHeap.Heapify();
+
+	EvictionHeapBuildTime = GetWorld()->GetTimeSeconds();
+}
+
+bool UObjectPoolingComponent::EvictActor(const TBitArray<>* ExcludedSlots)
+{
+	// Distances change every frame, so that ordering is rebuilt when it gets old instead of being kept up to date
+	if (EvictionPolicy == EPooledEvictionPolicy::FurthestFromViewers && GetWorld()->GetTimeSeconds() - EvictionHeapBuildTime > EvictionRefreshInterval)
+	{
+		RebuildEvictionHeapByDistance();
+	}
+
+	// Excluded slots are still valid candidates for later requests, so they go back on the heap afterwards
+	TArray<FPooledEvictionEntry, TInlineAllocator<16>> SkippedEntries;
+	bool bEvicted = false;
+	while (EvictionHeap.Num() > 0)
+	{
+		FPooledEvictionEntry Entry;
+		EvictionHeap.HeapPop(Entry, EAllowShrinking::No);
+		if (!IsEvictionEntryValid(Entry) || !IsValid(Pool[Entry.SlotIndex]))
+		{
+			continue;
+		}
+
+		if (ExcludedSlots && ExcludedSlots->IsValidIndex(Entry.SlotIndex) && (*ExcludedSlots)[Entry.SlotIndex])
+		{
+			SkippedEntries.Add(Entry);
+			continue;
+		}
+
+		if (ReturnSlotToPool(Entry.SlotIndex))
+		{
+			TotalEvictions++;
+			UE_LOG(LogObjectPool, Verbose, TEXT("Pool is exhausted, evicted %s to reuse it."), *GetNameSafe(Pool[Entry.SlotIndex]));
+			bEvicted = true;
+			break;
+		}
+	}
+
+	for (const FPooledEvictionEntry& Entry : SkippedEntries)
+	{
+		EvictionHeap.HeapPush(Entry);
+	}
+
+	return bEvicted;
+}
+
+void UObjectPoolingComponent::DeactivatePooledActor(AActor* Actor, int32 SlotIndex)
+{
+	bool bHandledByActor = false;
+	if (IPooledActorInterface* NativeInterface = GetNativeInterface(Actor))
+	{
+		bHandledByActor = NativeInterface->DeactivatePooledActor_Implementation();
+	}
+	else if (InterfaceDispatch == EPooledInterfaceDispatch::Reflected)
+	{
+		bHandledByActor = IPooledActorInterface::Execute_DeactivatePooledActor(Actor);
+	}
+
+	if (!bHandledByActor)
+	{
+		// Handle Actor Properties
+		Actor->SetActorHiddenInGame(true);
+		Actor->SetActorEnableCollision(false);
+		Actor->SetActorTickEnabled(false);
+
+		// Parking is optional, a hidden actor without collision does not need to move
+		switch (ParkingMode)
+		{
+		case EPooledActorParking::Origin:
+			Actor->SetActorLocation(FVector::ZeroVector, false, nullptr, ETeleportType::TeleportPhysics);
+			break;
+
+		case EPooledActorParking::ParkingLocation:
+			Actor->SetActorLocation(ParkingLocation, false, nullptr, ETeleportType::TeleportPhysics);
+			break;
+
+		default:
+			break;
+		}
+
+		if (SleepMode != EPooledActorSleepMode::None)
+		{
+			SleepPooledActor(Actor, SlotIndex);
+		}
+	}
+
+	// Stop replicating movement when the actor is returned to the pool
+	SetActorReplicationActive(Actor, false);
+}
+
+void UObjectPoolingComponent::SleepPooledActor(AActor* Actor, int32 SlotIndex)
+{
+	FPooledSleepState& SleepState = SlotSleepStates[SlotIndex];
+	SleepState.Mode = SleepMode;
+	SleepState.Components.Reset();
+
+	Actor->ForEachComponent<UPrimitiveComponent>(false, [this, &SleepState](UPrimitiveComponent* Primitive)
+	{
+		if (SleepMode == EPooledActorSleepMode::UnregisterPrimitives)
+		{
+			// Unregistering destroys both the physics bodies and the render proxy
+			if (Primitive->IsRegistered())
+			{
+				Primitive->UnregisterComponent();
+				SleepState.Components.Add(Primitive);
+			}
+		}
+		else if (Primitive->IsSimulatingPhysics())
+		{
+			// A sleeping kinematic body costs the solver nothing
+			Primitive->PutAllRigidBodiesToSleep();
+			Primitive->SetSimulatePhysics(false);
+			SleepState.Components.Add(Primitive);
+		}
+	});
+}
+
+void UObjectPoolingComponent::WakePooledActor(AActor* Actor, int32 SlotIndex, const FTransform* SpawnTransform)
+{
+	FPooledSleepState& SleepState = SlotSleepStates[SlotIndex];
+
+	if (SleepState.Mode == EPooledActorSleepMode::UnregisterPrimitives)
+	{
+		// Moving unregistered components only updates their transforms, the later move in the activation is then skipped
+		if (SpawnTransform)
+		{
+			Actor->SetActorTransform(*SpawnTransform, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+
+		for (const TWeakObjectPtr<UPrimitiveComponent>& Primitive : SleepState.Components)
+		{
+			if (Primitive.IsValid() && !Primitive->IsRegistered())
+			{
+				Primitive->RegisterComponent();
+			}
+		}
+	}
+	else
+	{
+		for (const TWeakObjectPtr<UPrimitiveComponent>& Primitive : SleepState.Components)
+		{
+			if (Primitive.IsValid())
+			{
+				Primitive->SetSimulatePhysics(true);
+				Primitive->WakeAllRigidBodies();
+			}
+		}
+	}
+
+	SleepState.Mode = EPooledActorSleepMode::None;
+	SleepState.Components.Reset();
+}
+
+void UObjectPoolingComponent::RecordSpawnedActors(int32 Count)
+{
+	CSV_CUSTOM_STAT(ObjectPool, Spawns, Count, ECsvCustomStatOp::Accumulate);
+
+	TotalObjectsCreated += Count;
+	ActiveObjects += Count;
+	UpdateInactiveObjects();
+
+	// Update peak usage if active objects exceed previous peak
+	if (ActiveObjects > PeakUsage)
+	{
+		PeakUsage = ActiveObjects;
+	}
+}
+
+void UObjectPoolingComponent::ApplySpawnLifespans(TConstArrayView<int32> SlotIndices)
+{
+	if (bUseTimerLifespan)
+	{
+		ScheduleLifespans(SlotIndices, ActorLifespan);
+	}
+	else if (bInterceptDestroy)
+	{
+		// Redirect the lifespan expiry into the pool.  Fall back to the class Initial Life Span when no lifespan is set on the pool.
+		ScheduleLifespans(SlotIndices, ActorLifespan > 0.f ? ActorLifespan : ClassInitialLifeSpan);
+	}
+	else
+	{
+		// This will cause the actor to destroy itself and then its slot is recycled by the next expansion.
+		// This works great if you do not want to manually reset data for reusing the actor.
+		for (const int32 SlotIndex : SlotIndices)
+		{
+			Pool[SlotIndex]->SetLifeSpan(ActorLifespan);
+		}
+	}
+}
+
+void UObjectPoolingComponent::ExpandPool(int32 Count)
+{
+	OBJECTPOOL_SCOPE_CYCLE_COUNTER(STAT_ObjectPool_ExpandPool);
+
+	// Check that there if a valid context object and valid class assigned to be pooled
+	if (!IsServer() || !GetWorld() || !PooledObjectClass || Count <= 0) return;
+
+	// Never grow past the hard cap
+	if (MaxPoolSize > 0)
+	{
+		Count = FMath::Min(Count, MaxPoolSize - GetNumPooledActors());
+		if (Count <= 0) return;
+	}
+
+	// Reserve the slot arrays once for the whole batch
+	ReserveSlots(Count);
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		AddPooledActor();
+	}
+}
+
+int32 UObjectPoolingComponent::GetGrowthCount() const
+{
+	const int32 LiveActors = GetNumPooledActors();
+
+	int32 GrowthCount = 1;
+	switch (GrowthMode)
+	{
+	case EPoolGrowthMode::FixedChunk:
+		GrowthCount = GrowthChunkSize;
+		break;
+
+	case EPoolGrowthMode::Geometric:
+		GrowthCount = FMath::CeilToInt32(LiveActors * (GrowthFactor - 1.f));
+		break;
+
+	case EPoolGrowthMode::PredictedPeak:
+		// Expect the next peak to exceed the largest one seen so far by the growth factor
+		GrowthCount = FMath::CeilToInt32(FMath::Max(PeakUsage, ActiveObjects + 1) * GrowthFactor) - LiveActors;
+		break;
+
+	default:
+		break;
+	}
+
+	GrowthCount = FMath::Max(GrowthCount, 1);
+	if (MaxPoolSize > 0)
+	{
+		GrowthCount = FMath::Min(GrowthCount, MaxPoolSize - LiveActors);
+	}
+	return GrowthCount;
+}
+
+AActor* UObjectPoolingComponent::SpawnIdleActor(AActor* Template)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Template = Template;
+	SpawnParams.bDeferConstruction = true;
+
+	// Idle actors never need the overlap test for a free spot
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	const FTransform SpawnTransform(ParkingMode == EPooledActorParking::ParkingLocation ? ParkingLocation : FVector::ZeroVector);
+	AActor* NewActor = GetWorld()->SpawnActor<AActor>(PooledObjectClass, SpawnTransform, SpawnParams);
+	if (!NewActor) return nullptr;
+
+	// Hidden and without collision before the components register, so no physics bodies are created for an idle actor
+	NewActor->SetActorHiddenInGame(true);
+	NewActor->SetActorEnableCollision(false);
+
+	if (InterfaceDispatch != EPooledInterfaceDispatch::None)
+	{
+		if (IPooledActorInterface* NativeInterface = GetNativeInterface(NewActor))
+		{
+			NativeInterface->PreparePooledActor_Implementation();
+		}
+		else
+		{
+			IPooledActorInterface::Execute_PreparePooledActor(NewActor);
+		}
+	}
+
+	NewActor->FinishSpawning(SpawnTransform);
+	if (!IsValid(NewActor)) return nullptr;
+
+	// BeginPlay enables the tick when the class starts with it enabled, so this has to wait until construction has finished
+	NewActor->SetActorTickEnabled(false);
+	return NewActor;
+}
+
+bool UObjectPoolingComponent::AddPooledActor()
+{
+	// Check for a valid context object and class, and never grow past the hard cap
+	if (!IsServer() || !GetWorld() || !PooledObjectClass || IsAtMaxPoolSize()) return false;
+
+	// Read from the class defaults, because template copies inherit the zeroed InitialLifeSpan of the template below
+	const float DefaultLifeSpan = PooledObjectClass->GetDefaultObject<AActor>()->InitialLifeSpan;
+	if (DefaultLifeSpan > 0.f)
+	{
+		ClassInitialLifeSpan = DefaultLifeSpan;
+	}
+
+	// The template is made on first use and again if something destroyed it, for example a seamless travel
+	if (bCloneFromTemplate && !IsValid(TemplateActor))
+	{
+		TemplateActor = SpawnIdleActor(nullptr);
+		if (TemplateActor)
+		{
+			// SetLifeSpan also writes InitialLifeSpan, so copies are spawned without one.  Replication is set up on each copy by InitializeActorReplication.
+			TemplateActor->SetLifeSpan(0.f);
+			TemplateActor->SetReplicates(false);
+		}
+	}
+
+	AActor* NewActor = SpawnIdleActor(bCloneFromTemplate ? TemplateActor : nullptr);
+	if (IsValid(NewActor))
+	{
+		// Cancel the lifespan the class sets on itself so a hidden pooled actor is never destroyed.  The pool applies it on spawn instead.
+		if (NewActor->InitialLifeSpan > 0.f)
+		{
+			NewActor->SetLifeSpan(0.f);
+		}
+
+		// Set replication on the new actor
+		InitializeActorReplication(NewActor);
+
+		// Bound once per actor so destroyed actors are removed from the pool instead of becoming stale entries
+		NewActor->OnDestroyed.AddDynamic(this, &UObjectPoolingComponent::HandleDestroyedActor);
+
+		// Add the actor to the pool and mark its slot as free
+		const int32 SlotIndex = AddSlot(NewActor);
+
+		// New actors start idle, so they go straight into deep sleep
+		if (SleepMode != EPooledActorSleepMode::None)
+		{
+			SleepPooledActor(NewActor, SlotIndex);
+		}
+
+		// Recalculate the inactive objects and increment objects created and amount of expansions
+		CSV_CUSTOM_STAT(ObjectPool, Expansions, 1, ECsvCustomStatOp::Accumulate);
+		TotalObjectsCreated++;
+		TotalPoolExpansions++;
+		UpdateInactiveObjects();
+		return true;
+	}
+
+	UE_CLOG(ShouldLogPoolWarning(), LogObjectPool, Error, TEXT("Failed to spawn actor for the pool."));
+	return false;
+}
+
+int32 UObjectPoolingComponent::AddSlot(AActor* Actor)
+{
+	int32 SlotIndex;
+	if (DeadSlots.Num() > 0)
+	{
+		// Dead slots were already reset by RemoveDeadSlot, only the actor changes
+		SlotIndex = DeadSlots.Pop(EAllowShrinking::No);
+		Pool[SlotIndex] = Actor;
+	}
+	else
+	{
+		SlotIndex = Pool.Add(Actor);
+		SlotInUse.Add(false);
+		SlotGenerations.Add(0);
+		SlotExpiryTimes.Add(0.0);
+		SlotRequesters.AddDefaulted();
+		SlotSleepStates.AddDefaulted();
+		SlotFreeIndices.Add(INDEX_NONE);
+		SlotCells.AddDefaulted();
+		SlotCellIndices.Add(INDEX_NONE);
+	}
+
+	PushFreeSlot(SlotIndex, Actor->GetActorLocation());
+	SlotLookup.Add(Actor, SlotIndex);
+
+	if (ReturnDistance > 0.f && !ReturnDistanceTimer.IsValid())
+	{
+		GetWorld()->GetTimerManager().SetTimer(ReturnDistanceTimer, this, &UObjectPoolingComponent::ReturnDistantActors, ReturnDistanceInterval, true);
+	}
+
+	if (bClusterIdleActors)
+	{
+		// A new chunk starts its idle time now
+		const int32 NumChunks = Pool.Num() / IdleClusterSize + 1;
+		if (ChunkClusters.Num() < NumChunks)
+		{
+			ChunkClusters.SetNumZeroed(NumChunks);
+			ChunkLastUseTimes.SetNumZeroed(NumChunks);
+		}
+		ChunkLastUseTimes[SlotIndex / IdleClusterSize] = GetWorld()->GetTimeSeconds();
+
+		if (!IdleClusterTimer.IsValid())
+		{
+			GetWorld()->GetTimerManager().SetTimer(IdleClusterTimer, this, &UObjectPoolingComponent::ClusterIdleChunks, FMath::Max(IdleClusterDelay * 0.5f, 1.f), true);
+		}
+	}
+
+	return SlotIndex;
+}
+
+void UObjectPoolingComponent::ClusterIdleChunks()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (int32 ChunkIndex = 0; ChunkIndex < ChunkClusters.Num(); ++ChunkIndex)
+	{
+		if (ChunkClusters[ChunkIndex] || Now - ChunkLastUseTimes[ChunkIndex] < IdleClusterDelay)
+		{
+			continue;
+		}
+
+		// Only complete chunks where every actor is idle and alive are clustered
+		const int32 FirstSlot = ChunkIndex * IdleClusterSize;
+		if (FirstSlot + IdleClusterSize > Pool.Num() || SlotInUse.CountSetBits(FirstSlot, FirstSlot + IdleClusterSize) != 0)
+		{
+			continue;
+		}
+
+		UPooledActorCluster* Cluster = NewObject<UPooledActorCluster>(this);
+		Cluster->Actors.Reserve(IdleClusterSize);
+		for (int32 SlotIndex = FirstSlot; SlotIndex < FirstSlot + IdleClusterSize; ++SlotIndex)
+		{
+			AActor* Actor = Pool[SlotIndex];
+			if (!IsValid(Actor) || Actor->HasAnyInternalFlags(EInternalObjectFlags::ClusterRoot))
+			{
+				break;
+			}
+			Cluster->Actors.Add(Actor);
+		}
+
+		if (Cluster->Actors.Num() != IdleClusterSize)
+		{
+			continue;
+		}
+
+		if (!Cluster->Actors[0]->CanBeInCluster())
+		{
+			UE_LOG(LogObjectPool, Warning, TEXT("%s cannot be put in a GC cluster, enable Can Be In Cluster on the class.  Idle clustering is turned off for this pool."), *GetNameSafe(PooledObjectClass));
+			bClusterIdleActors = false;
+			GetWorld()->GetTimerManager().ClearTimer(IdleClusterTimer);
+			return;
+		}
+
+		Cluster->CreateCluster();
+		if (Cluster->HasAnyInternalFlags(EInternalObjectFlags::ClusterRoot))
+		{
+			ChunkClusters[ChunkIndex] = Cluster;
+		}
+
+		// Cluster creation walks every actor, so build at most one per check
+		return;
+	}
+}
+
+void UObjectPoolingComponent::DissolveChunkCluster(int32 SlotIndex)
+{
+	const int32 ChunkIndex = SlotIndex / IdleClusterSize;
+	if (ChunkClusters.IsValidIndex(ChunkIndex) && ChunkClusters[ChunkIndex])
+	{
+		GUObjectClusters.DissolveCluster(ChunkClusters[ChunkIndex]);
+		ChunkClusters[ChunkIndex] = nullptr;
+	}
+
+	if (ChunkLastUseTimes.IsValidIndex(ChunkIndex) && GetWorld())
+	{
+		ChunkLastUseTimes[ChunkIndex] = GetWorld()->GetTimeSeconds();
+	}
+}
+
+void UObjectPoolingComponent::DissolveAllChunkClusters()
+{
+	for (UPooledActorCluster*& Cluster : ChunkClusters)
+	{
+		if (Cluster)
+		{
+			GUObjectClusters.DissolveCluster(Cluster);
+			Cluster = nullptr;
+		}
+	}
+}
+
+void UObjectPoolingComponent::PushFreeSlot(int32 SlotIndex, const FVector& Location)
+{
+	SlotFreeIndices[SlotIndex] = FreeSlots.Add(SlotIndex);
+
+	if (bSpatialReuse)
+	{
+		const FIntPoint Cell = GetSpatialCell(Location);
+		SlotCells[SlotIndex] = Cell;
+		SlotCellIndices[SlotIndex] = SpatialFreeSlots.FindOrAdd(Cell).Add(SlotIndex);
+	}
+}
+
+void UObjectPoolingComponent::RemoveFreeSlot(int32 SlotIndex)
+{
+	const int32 FreeIndex = SlotFreeIndices[SlotIndex];
+	if (FreeIndex == INDEX_NONE) return;
+
+	// Swap removal, the slot moved into the gap gets its new position
+	FreeSlots.RemoveAtSwap(FreeIndex, 1, EAllowShrinking::No);
+	if (FreeSlots.IsValidIndex(FreeIndex))
+	{
+		SlotFreeIndices[FreeSlots[FreeIndex]] = FreeIndex;
+	}
+	SlotFreeIndices[SlotIndex] = INDEX_NONE;
+
+	RemoveFromSpatialCell(SlotIndex);
+}
+
+void UObjectPoolingComponent::RemoveFromSpatialCell(int32 SlotIndex)
+{
+	const int32 CellIndex = SlotCellIndices[SlotIndex];
+	if (CellIndex != INDEX_NONE)
+	{
+		// Empty cells are kept, actors tend to be returned to the same areas again
+		TArray<int32>& CellSlots = SpatialFreeSlots.FindChecked(SlotCells[SlotIndex]);
+		CellSlots.RemoveAtSwap(CellIndex, 1, EAllowShrinking::No);
+		if (CellSlots.IsValidIndex(CellIndex))
+		{
+			SlotCellIndices[CellSlots[CellIndex]] = CellIndex;
+		}
+		SlotCellIndices[SlotIndex] = INDEX_NONE;
+	}
+}
+
+int32 UObjectPoolingComponent::PopFreeSlot()
+{
+	const int32 SlotIndex = FreeSlots.Last();
+	RemoveFreeSlot(SlotIndex);
+	return SlotIndex;
+}
+
+void UObjectPoolingComponent::PopColdestFreeSlots(int32 Count, TArray<int32, TInlineAllocator<16>>& OutSlots)
+{
+	Count = FMath::Min(Count, FreeSlots.Num());
+	if (Count <= 0) return;
+
+	// Swap removal would move the hottest slot to the cold end, so the front is removed in order instead
+	OutSlots.Append(FreeSlots.GetData(), Count);
+	FreeSlots.RemoveAt(0, Count, EAllowShrinking::No);
+	for (const int32 SlotIndex : OutSlots)
+	{
+		SlotFreeIndices[SlotIndex] = INDEX_NONE;
+		RemoveFromSpatialCell(SlotIndex);
+	}
+	for (int32 FreeIndex = 0; FreeIndex < FreeSlots.Num(); ++FreeIndex)
+	{
+		SlotFreeIndices[FreeSlots[FreeIndex]] = FreeIndex;
+	}
+}
+
+int32 UObjectPoolingComponent::PopNearestFreeSlot(const FVector& Location)
+{
+	// Search outwards ring by ring, so the spawn location's own cell is always tried first
+	const FIntPoint Center = GetSpatialCell(Location);
+	for (int32 Ring = 0; Ring <= SpatialSearchRings; ++Ring)
+	{
+		for (int32 Y = -Ring; Y <= Ring; ++Y)
+		{
+			for (int32 X = -Ring; X <= Ring; ++X)
+			{
+				if (FMath::Max(FMath::Abs(X), FMath::Abs(Y)) != Ring)
+				{
+					continue;
+				}
+
+				const TArray<int32>* CellSlots = SpatialFreeSlots.Find(Center + FIntPoint(X, Y));
+				if (CellSlots && CellSlots->Num() > 0)
+				{
+					const int32 SlotIndex = CellSlots->Last();
+					RemoveFreeSlot(SlotIndex);
+					return SlotIndex;
+				}
+			}
+		}
+	}
+
+	return PopFreeSlot();
+}
+
+FIntPoint UObjectPoolingComponent::GetSpatialCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / SpatialCellSize), FMath::FloorToInt32(Location.Y / SpatialCellSize));
+}
+
+void UObjectPoolingComponent::ReturnDistantActors()
+{
+	if (ReturnDistance <= 0.f || ActiveObjects == 0) return;
+
+	TArray<FVector> ViewerLocations;
+	GetViewerLocations(ViewerLocations);
+	if (ViewerLocations.Num() == 0) return;
+
+	// Returning clears bits, so collect the slots first
+	const double ReturnDistanceSquared = FMath::Square(static_cast<double>(ReturnDistance));
+	TArray<int32, TInlineAllocator<64>> DistantSlots;
+	for (TConstSetBitIterator<> It(SlotInUse); It; ++It)
+	{
+		const AActor* Actor = Pool[It.GetIndex()];
+		if (!IsValid(Actor)) continue;
+
+		const FVector ActorLocation = Actor->GetActorLocation();
+		const bool bNearViewer = ViewerLocations.ContainsByPredicate([&ActorLocation, ReturnDistanceSquared](const FVector& ViewerLocation)
+		{
+			return FVector::DistSquared(ActorLocation, ViewerLocation) <= ReturnDistanceSquared;
+		});
+
+		if (!bNearViewer)
+		{
+			DistantSlots.Add(It.GetIndex());
+		}
+	}
+
+	for (const int32 SlotIndex : DistantSlots)
+	{
+		ReturnSlotToPool(SlotIndex);
+	}
+}
+
+void UObjectPoolingComponent::GetViewerLocations(TArray<FVector>& OutLocations) const
+{
+	// The server has a controller for every player, remote ones report their replicated view
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APlayerController* PlayerController = It->Get())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			OutLocations.Add(ViewLocation);
+		}
+	}
+}
+
+void UObjectPoolingComponent::ReserveSlots(int32 Count)
+{
+	// Dead slots are refilled first, so only the rest grows the per slot arrays
+	const int32 NewSlots = FMath::Max(Count - DeadSlots.Num(), 0);
+	Pool.Reserve(Pool.Num() + NewSlots);
+	SlotInUse.Reserve(SlotInUse.Num() + NewSlots);
+	SlotGenerations.Reserve(SlotGenerations.Num() + NewSlots);
+	SlotExpiryTimes.Reserve(SlotExpiryTimes.Num() + NewSlots);
+	SlotRequesters.Reserve(SlotRequesters.Num() + NewSlots);
+	SlotSleepStates.Reserve(SlotSleepStates.Num() + NewSlots);
+	SlotFreeIndices.Reserve(SlotFreeIndices.Num() + NewSlots);
+	SlotCells.Reserve(SlotCells.Num() + NewSlots);
+	SlotCellIndices.Reserve(SlotCellIndices.Num() + NewSlots);
+	FreeSlots.Reserve(FreeSlots.Num() + Count);
+	SlotLookup.Reserve(SlotLookup.Num() + Count);
+}
+
+void UObjectPoolingComponent::GetActiveActors(TArray<AActor*>& OutActors) const
+{
+	if (SharedPool)
+	{
+		SharedPool->GetActiveActors(OutActors);
+		return;
+	}
+
+	OutActors.Reset(ActiveObjects);
+	for (TConstSetBitIterator<> It(SlotInUse); It; ++It)
+	{
+		OutActors.Add(Pool[It.GetIndex()]);
+	}
+}
+
+void UObjectPoolingComponent::ScheduleLifespans(TConstArrayView<int32> SlotIndices, float Lifespan)
+{
+	// A lifespan of zero keeps the actor out until it is returned manually
+	if (Lifespan <= 0.f || SlotIndices.Num() == 0)
+	{
+		return;
+	}
+
+	// Every actor in the batch shares the same expiry time
+	const double ExpiryTime = GetWorld()->GetTimeSeconds() + Lifespan;
+	LifespanHeap.Reserve(LifespanHeap.Num() + SlotIndices.Num());
+	for (const int32 SlotIndex : SlotIndices)
+	{
+		SlotExpiryTimes[SlotIndex] = ExpiryTime;
+		LifespanHeap.HeapPush({ ExpiryTime, SlotIndex });
+	}
+
+	RefreshTickEnabled();
+}
+
+void UObjectPoolingComponent::ProcessExpiredLifespans()
+{
+	OBJECTPOOL_SCOPE_CYCLE_COUNTER(STAT_ObjectPool_ProcessExpiredLifespans);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Collect every expired slot first so returning actors cannot disturb the heap while it is being drained
+	TArray<int32, TInlineAllocator<32>> ExpiredSlots;
+	while (LifespanHeap.Num() > 0 && LifespanHeap.HeapTop().ExpiryTime <= Now)
+	{
+		FPooledLifespanEntry Entry;
+		LifespanHeap.HeapPop(Entry, EAllowShrinking::No);
+
+		// Skip entries for slots that were returned early or reused with a new lifespan
+		if (SlotInUse[Entry.SlotIndex] && SlotExpiryTimes[Entry.SlotIndex] == Entry.ExpiryTime)
+		{
+			ExpiredSlots.Add(Entry.SlotIndex);
+		}
+	}
+
+	for (const int32 SlotIndex : ExpiredSlots)
+	{
+		ReturnSlotToPool(SlotIndex);
+	}
+}
+
+void UObjectPoolingComponent::TickAdaptiveSizing(float DeltaTime)
+{
+	OBJECTPOOL_SCOPE_CYCLE_COUNTER(STAT_ObjectPool_AdaptiveSizing);
+
+	// Decay the high water mark towards the current demand, it never drops below what is active right now
+	const float Decay = DemandHalfLife > 0.f ? FMath::Exp2(-DeltaTime / DemandHalfLife) : 0.f;
+	DecayedPeakUsage = FMath::Max(static_cast<float>(ActiveObjects), DecayedPeakUsage * Decay);
+
+	const int32 TargetSize = GetAdaptiveTargetSize();
+	const int32 PlannedSize = GetNumPooledActors() + PendingPrewarmCount + PendingGrowthCount;
+
+	// Grow ahead of demand in chunks.  The actors are spawned over the next frames within the prewarm budget.
+	if (PlannedSize < TargetSize)
+	{
+		int32 GrowBy = FMath::Max(TargetSize - PlannedSize, AdaptiveGrowthChunk);
+		if (MaxPoolSize > 0)
+		{
+			GrowBy = FMath::Min(GrowBy, MaxPoolSize - PlannedSize);
+		}
+		PendingGrowthCount += FMath::Max(GrowBy, 0);
+		return;
+	}
+
+	// Only shrink once the surplus is larger than a growth chunk so growth is not undone straight away.
+	// The reserved size is the floor, the decayed peak starts at zero and would otherwise undo the prewarm
+	const int32 Surplus = PlannedSize - FMath::Max(TargetSize, PoolSize);
+	if (PendingPrewarmCount > 0 || PendingGrowthCount > 0 || Surplus <= AdaptiveGrowthChunk)
+	{
+		return;
+	}
+
+	// Destroy surplus idle actors within the per-frame budget.  The coldest go first, the recently returned ones are the ones being reused
+	TArray<int32, TInlineAllocator<16>> SurplusSlots;
+	PopColdestFreeSlots(FMath::Min(Surplus, ShrinkActorsPerFrame), SurplusSlots);
+	for (const int32 SlotIndex : SurplusSlots)
+	{
+		AActor* Actor = Pool[SlotIndex];
+
+		RemoveDeadSlot(SlotIndex);
+		if (IsValid(Actor))
+		{
+			Actor->OnDestroyed.RemoveDynamic(this, &UObjectPoolingComponent::HandleDestroyedActor);
+			Actor->Destroy();
+		}
+	}
+}
+
+int32 UObjectPoolingComponent::GetAdaptiveTargetSize() const
+{
+	const int32 TargetSize = FMath::CeilToInt32(DecayedPeakUsage * (1.f + AdaptiveHeadroom));
+	return FMath::Clamp(TargetSize, MinPoolSize, MaxPoolSize > 0 ? MaxPoolSize : MAX_int32);
+}
+
+bool UObjectPoolingComponent::ShouldLogPoolWarning()
+{
+	// Pool pressure warnings can fire on every request during a surge, so only let one through per interval
+	constexpr double WarningInterval = 5.0;
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastPoolWarningTime < WarningInterval)
+	{
+		return false;
+	}
+
+	LastPoolWarningTime = Now;
+	return true;
+}
+
+void UObjectPoolingComponent::CopyPoolSettingsFrom(const UObjectPoolingComponent* Source)
+{
+	if (!Source) return;
+
+	bAutoExpand = Source->bAutoExpand;
+	ActorLifespan = Source->ActorLifespan;
+	bUseTimerLifespan = Source->bUseTimerLifespan;
+	bInterceptDestroy = Source->bInterceptDestroy;
+	ReplicationPolicy = Source->ReplicationPolicy;
+	PrewarmActorsPerFrame = Source->PrewarmActorsPerFrame;
+	PrewarmMillisecondsPerFrame = Source->PrewarmMillisecondsPerFrame;
+	InitialPoolSize = Source->InitialPoolSize;
+	bAdaptiveSizing = Source->bAdaptiveSizing;
+	MinPoolSize = Source->MinPoolSize;
+	MaxPoolSize = Source->MaxPoolSize;
+	DemandHalfLife = Source->DemandHalfLife;
+	AdaptiveHeadroom = Source->AdaptiveHeadroom;
+	AdaptiveGrowthChunk = Source->AdaptiveGrowthChunk;
+	ShrinkActorsPerFrame = Source->ShrinkActorsPerFrame;
+	GrowthMode = Source->GrowthMode;
+	GrowthChunkSize = Source->GrowthChunkSize;
+	GrowthFactor = Source->GrowthFactor;
+	bDeferredOverflow = Source->bDeferredOverflow;
+	ParkingMode = Source->ParkingMode;
+	ParkingLocation = Source->ParkingLocation;
+	SleepMode = Source->SleepMode;
+	bClientPrediction = Source->bClientPrediction;
+	PredictedActorClass = Source->PredictedActorClass;
+	MirrorPoolSize = Source->MirrorPoolSize;
+	PredictionTimeout = Source->PredictionTimeout;
+	bKeepAcrossSeamlessTravel = Source->bKeepAcrossSeamlessTravel;
+	bClusterIdleActors = Source->bClusterIdleActors;
+	IdleClusterSize = Source->IdleClusterSize;
+	IdleClusterDelay = Source->IdleClusterDelay;
+	bSpatialReuse = Source->bSpatialReuse;
+	SpatialCellSize = Source->SpatialCellSize;
+	SpatialSearchRings = Source->SpatialSearchRings;
+	ReturnDistance = Source->ReturnDistance;
+	ReturnDistanceInterval = Source->ReturnDistanceInterval;
+	EvictionPolicy = Source->EvictionPolicy;
+	EvictionRefreshInterval = Source->EvictionRefreshInterval;
+	bCloneFromTemplate = Source->bCloneFromTemplate;
+}
+
+void UObjectPoolingComponent::ApplyPoolDefinition(const FObjectPoolDefinition& Definition)
+{
+	bAutoExpand = Definition.bAutoExpand;
+	GrowthMode = Definition.GrowthMode;
+	GrowthChunkSize = Definition.GrowthChunkSize;
+	GrowthFactor = Definition.GrowthFactor;
+	bAdaptiveSizing = Definition.bAdaptiveSizing;
+	MinPoolSize = Definition.MinSize;
+	MaxPoolSize = Definition.MaxSize;
+	ActorLifespan = Definition.ActorLifespan;
+	bUseTimerLifespan = Definition.bUseTimerLifespan;
+	PrewarmActorsPerFrame = Definition.PrewarmActorsPerFrame;
+	PrewarmMillisecondsPerFrame = Definition.PrewarmMillisecondsPerFrame;
+	bKeepAcrossSeamlessTravel = Definition.bKeepAcrossSeamlessTravel;
+
+	// A running pool that just turned on adaptive sizing needs its tick back
+	if (IsRegistered())
+	{
+		RefreshTickEnabled();
+	}
+}
+
+void UObjectPoolingComponent::PrepareForSeamlessTravel(TArray<AActor*>& ActorList)
+{
+	if (SharedPool || !IsServer())
+	{
+		return;
+	}
+
+	// Clusters do not survive the move between worlds
+	DissolveAllChunkClusters();
+
+	// Everything arrives in the next map idle
+	TArray<AActor*> ActiveActors;
+	GetActiveActors(ActiveActors);
+	ReturnObjectsToPool(ActiveActors);
+
+	// World time starts over in the next map, so no heap entry stays meaningful
+	LifespanHeap.Reset();
+	EvictionHeap.Reset();
+	EvictionHeapBuildTime = -1.0;
+
+	// Idle times count from the start of the next map
+	for (double& LastUseTime : ChunkLastUseTimes)
+	{
+		LastUseTime = 0.0;
+	}
+
+	ActorList.Reserve(ActorList.Num() + GetNumPooledActors());
+	for (AActor* Actor : Pool)
+	{
+		if (IsValid(Actor))
+		{
+			ActorList.Add(Actor);
+		}
+	}
+
+	UE_LOG(LogObjectPool, Log, TEXT("Keeping %d pooled actors across seamless travel."), GetNumPooledActors());
+}
+
+void UObjectPoolingComponent::CachePooledClassInterface()
+{
+	InterfaceDispatch = EPooledInterfaceDispatch::None;
+	NativeInterfaceOffset = 0;
+
+	// The pooled class is fixed per pool, so the interface list only has to be searched once
+	if (!PooledObjectClass || !PooledObjectClass->ImplementsInterface(UPooledActorInterface::StaticClass()))
+	{
+		return;
+	}
+
+	InterfaceDispatch = EPooledInterfaceDispatch::Reflected;
+
+	// Only interfaces implemented in C++ have a native address, Blueprint implementations always go through ProcessEvent
+	AActor* DefaultActor = PooledObjectClass->GetDefaultObject<AActor>();
+	IPooledActorInterface* NativeInterface = Cast<IPooledActorInterface>(DefaultActor);
+	if (!NativeInterface)
+	{
+		return;
+	}
+
+	// A Blueprint child of a C++ implementer may override any of the events, those must keep going through reflection
+	auto IsOverriddenInBlueprint = [this](FName FunctionName)
+	{
+		const UFunction* Function = PooledObjectClass->FindFunctionByName(FunctionName);
+		return Function && !Function->GetOwnerClass()->HasAnyClassFlags(CLASS_Native);
+	};
+
+	if (IsOverriddenInBlueprint(GET_FUNCTION_NAME_CHECKED(IPooledActorInterface, PreparePooledActor))
+		|| IsOverriddenInBlueprint(GET_FUNCTION_NAME_CHECKED(IPooledActorInterface, ResetPooledActor))
+		|| IsOverriddenInBlueprint(GET_FUNCTION_NAME_CHECKED(IPooledActorInterface, ActivatePooledActor))
+		|| IsOverriddenInBlueprint(GET_FUNCTION_NAME_CHECKED(IPooledActorInterface, DeactivatePooledActor))
+		|| IsOverriddenInBlueprint(GET_FUNCTION_NAME_CHECKED(IPooledActorInterface, GetPooledActorEvictionPriority)))
+	{
+		return;
+	}
+
+	// Every pooled actor has the exact pooled class, so the interface sits at the same offset in each of them
+	InterfaceDispatch = EPooledInterfaceDispatch::Native;
+	NativeInterfaceOffset = static_cast<SIZE_T>(reinterpret_cast<uint8*>(NativeInterface) - reinterpret_cast<uint8*>(DefaultActor));
+}
+
+IPooledActorInterface* UObjectPoolingComponent::GetNativeInterface(AActor* Actor) const
+{
+	return InterfaceDispatch == EPooledInterfaceDispatch::Native
+		? reinterpret_cast<IPooledActorInterface*>(reinterpret_cast<uint8*>(Actor) + NativeInterfaceOffset)
+		: nullptr;
+}
+
+void UObjectPoolingComponent::InitializeActorReplication(AActor* Actor) const
+{
+	// Mirror pool actors are client local cosmetics
+	if (bLocalOnly)
+	{
+		Actor->SetReplicates(false);
+		return;
+	}
+
+	Actor->SetReplicates(true);
+
+	if (ReplicationPolicy == EPooledReplicationPolicy::Dormancy)
+	{
+		// Keep the channel open for the lifetime of the pool and let dormancy stop updates while pooled
+		Actor->SetReplicateMovement(true);
+		Actor->SetNetDormancy(DORM_DormantAll);
+	}
+	else if (ReplicationPolicy == EPooledReplicationPolicy::ReplicationGraph)
+	{
+		// The graph node decides whether the actor is gathered, so replication itself never changes
+		Actor->SetReplicateMovement(true);
+	}
+	else
+	{
+		Actor->SetReplicateMovement(false);
+	}
+}
+
+void UObjectPoolingComponent::SetActorReplicationActive(AActor* Actor, bool bActive) const
+{
+	if (bLocalOnly)
+	{
+		return;
+	}
+
+	if (ReplicationPolicy == EPooledReplicationPolicy::Dormancy)
+	{
+		// Waking flushes the pending state, going dormant still sends the final hidden state before the channel sleeps
+		Actor->SetNetDormancy(bActive ? DORM_Awake : DORM_DormantAll);
+		return;
+	}
+
+	if (ReplicationPolicy == EPooledReplicationPolicy::ReplicationGraph)
+	{
+		// Send the change on the next replication frame, for a returned actor this is its last update until reuse
+		OnPooledActorActivityChanged.Broadcast(Actor, bActive);
+		Actor->ForceNetUpdate();
+		return;
+	}
+
+	Actor->SetReplicates(bActive);
+	Actor->SetReplicateMovement(bActive);
+}
@@ -0,0 +1,25 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "PooledActorCluster.generated.h"
+
+/**
+ * GC cluster root for a chunk of idle pooled actors.  While the cluster exists, reachability marks the chunk as one unit
+ * instead of traversing every actor and its subobjects.
+ */
+UCLASS(Transient)
+class UPooledActorCluster : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool CanBeClusterRoot() const override { return true; }
+
+	/* Idle actors in the cluster.  They are pulled in together with their components when the cluster is created */
+	UPROPERTY()
+	TArray<AActor*> Actors;
+};
@@ -5,6 +5,13 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+// Pool diagnostics.  Shipping builds compile out everything below Warning.
+#if UE_BUILD_SHIPPING
+DYNAMICOBJECTPOOLER_API DECLARE_LOG_CATEGORY_EXTERN(LogObjectPool, Warning, Warning);
+#else
+DYNAMICOBJECTPOOLER_API DECLARE_LOG_CATEGORY_EXTERN(LogObjectPool, Log, All);
+#endif
+
 class FDynamicObjectPoolerModule : public IModuleInterface
 {
 public:
@@ -12,4 +19,9 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+
+	/* Adds UObjectPoolConfig to the asset manager's primary asset types, scanned under /Game and always cooked */
+	static void RegisterPoolConfigAssetType();
 };
@@ -0,0 +1,155 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "ObjectInstancePoolingComponent.generated.h"
+
+class USceneComponent;
+
+// Used for when an object is acquired from the instance pool
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPooledObjectAcquired, UObject*, Object);
+
+// Used for when an object is released back to the instance pool
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPooledObjectReleased, UObject*, Object);
+
+/**
+ * Pool for components and plain UObjects, such as Niagara, audio and decal components spawned per impact.  Components are created on
+ * this component's owner and stay registered for the lifetime of the pool, so reuse only activates, moves and shows them.
+ * Objects implementing IPooledActorInterface get the same reset, activate and deactivate calls as pooled actors.
+ * Pools run locally on every machine, pooled instances are cosmetic and never replicate.
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class DYNAMICOBJECTPOOLER_API UObjectInstancePoolingComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UObjectInstancePoolingComponent();
+
+	/* Initializes the pool with a component or object class.  Actor classes belong in UObjectPoolingComponent */
+	UFUNCTION(BlueprintCallable, Category="Dynamic Object Pooling")
+	void InitializePool(TSubclassOf<UObject> ObjectClass, int32 InitialSize);
+
+	/* Gets an idle object from the pool, expanding it if allowed.  Components are activated and shown where they are,
+	 * and ActivatePooledActor receives their current transform */
+	UFUNCTION(BlueprintCallable, Category="Dynamic Object Pooling")
+	UObject* AcquireObject();
+
+	/* Gets an idle scene component from the pool, places it at the transform, attaches it if a parent is given and activates it */
+	UFUNCTION(BlueprintCallable, Category="Dynamic Object Pooling")
+	UActorComponent* AcquireComponent(const FTransform& WorldTransform, USceneComponent* AttachParent = nullptr);
+
+	/* Returns an object to the pool.  Components are deactivated, hidden and detached */
+	UFUNCTION(BlueprintCallable, Category="Dynamic Object Pooling")
+	void ReleaseObject(UObject* Object);
+
+	/* The component or object class this pool creates, null until the pool is initialized */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="Dynamic Object Pooling")
+	TSubclassOf<UObject> GetPooledObjectClass() const { return PooledObjectClass; }
+
+	// Get the number of live objects held by the pool, both active and inactive
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Pooling")
+	int32 GetNumPooledObjects() const { return Pool.Num() - DeadSlots.Num(); }
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Dynamic Object Pooling | Configuration")
+	bool bAutoExpand = true;
+
+	/* Hard cap on live objects.  0 means unlimited */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Dynamic Object Pooling | Configuration", meta = (ClampMin = "0", UIMin = "0"))
+	int32 MaxPoolSize = 0;
+
+	UPROPERTY(BlueprintAssignable, Category = "Dynamic Object Pooling | Delegates")
+	FOnPooledObjectAcquired OnPooledObjectAcquired;
+
+	UPROPERTY(BlueprintAssignable, Category = "Dynamic Object Pooling | Delegates")
+	FOnPooledObjectReleased OnPooledObjectReleased;
+
+
+	/* Pooling Statistics Variables */
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
+	int32 TotalObjectsCreated = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
+	int32 ActiveObjects = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
+	int32 InactiveObjects = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
+	int32 TotalSpawnRequests = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
+	int32 TotalReturnRequests = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
+	int32 TotalPoolExpansions = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
+	int32 PeakUsage = 0;
+
+	/* Acquires served straight from an idle object */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
+	int32 TotalPoolHits = 0;
+
+	/* Acquires that had to create an object or failed */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
+	int32 TotalPoolMisses = 0;
+
+protected:
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+
+	/* The component or object class that will be pooled */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Dynamic Object Pooling", meta = (AllowPrivateAccess = "true"))
+	TSubclassOf<UObject> PooledObjectClass;
+
+	/* Every instance created by the pool, indexed by slot */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Dynamic Object Pooling", meta = (AllowPrivateAccess = "true"))
+	TArray<UObject*> Pool;
+
+	/* Stack of indices into Pool that are free to be handed out */
+	TArray<int32> FreeSlots;
+
+	/* One bit per slot in Pool, set while the object is handed out */
+	TBitArray<> SlotInUse;
+
+	/* Maps each pooled object to its slot in Pool */
+	TMap<const UObject*, int32> SlotLookup;
+
+	/* Slots whose object was destroyed outside the pool, refilled before the pool grows */
+	TArray<int32> DeadSlots;
+
+	/* Set once per class when it implements IPooledActorInterface */
+	bool bImplementsPooledInterface = false;
+
+	/* Creates objects until the pool holds Count more, within MaxPoolSize */
+	void ExpandPool(int32 Count);
+
+	/* Releases a destroyed object's slot so ExpandPool can recycle it.  Free slots must already be off the FreeSlots stack */
+	void RemoveDeadSlot(int32 SlotIndex);
+
+	/* Pops a free slot whose object is still alive, expanding the pool if allowed */
+	UObject* AcquireFromPool();
+
+	/* Resets and enables an acquired object */
+	void ActivateObject(UObject* Object, const FTransform* WorldTransform, USceneComponent* AttachParent);
+
+	/* Disables a released object */
+	void DeactivateObject(UObject* Object);
+
+	/* Recalculates InactiveObjects from the live slot count */
+	void UpdateInactiveObjects();
+
+	/* Counts this pool last contributed to the process wide Insights and CSV instance counters */
+	int32 ReportedActiveObjects = 0;
+	int32 ReportedInactiveObjects = 0;
+
+	/* Replaces this pool's contribution to the process wide instance counters */
+	void PublishPoolCounters(int32 Active, int32 Inactive);
+};
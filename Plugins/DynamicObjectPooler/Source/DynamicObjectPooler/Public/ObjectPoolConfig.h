@@ -0,0 +1,92 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ObjectPoolingComponent.h"
+#include "ObjectPoolConfig.generated.h"
+
+/* Setup of one shared pool in a UObjectPoolConfig */
+USTRUCT(BlueprintType)
+struct FObjectPoolDefinition
+{
+	GENERATED_BODY()
+
+	/* Class to pool.  Part of the Pooled asset bundle, so the cooker puts it in the same chunk as the config */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling", meta = (AssetBundles = "Pooled"))
+	TSoftClassPtr<AActor> ActorClass;
+
+	/* Pools with a higher priority are prewarmed first */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling")
+	int32 Priority = 0;
+
+	/* Actors spawned by the prewarm pass */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling", meta = (ClampMin = "0", UIMin = "0"))
+	int32 InitialSize = 10;
+
+	/* Adaptive sizing never shrinks the pool below this many live actors */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling", meta = (ClampMin = "0", UIMin = "0"))
+	int32 MinSize = 0;
+
+	/* Hard cap on live actors.  0 means unlimited */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling", meta = (ClampMin = "0", UIMin = "0"))
+	int32 MaxSize = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Growth")
+	bool bAutoExpand = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Growth", meta = (EditCondition = "bAutoExpand"))
+	EPoolGrowthMode GrowthMode = EPoolGrowthMode::FixedChunk;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Growth", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bAutoExpand"))
+	int32 GrowthChunkSize = 8;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Growth", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bAutoExpand"))
+	float GrowthFactor = 1.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Growth")
+	bool bAdaptiveSizing = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Lifespan")
+	float ActorLifespan = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Lifespan")
+	bool bUseTimerLifespan = true;
+
+	/* Max actors spawned per frame for this pool during the prewarm pass */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Budget", meta = (ClampMin = "1", UIMin = "1"))
+	int32 PrewarmActorsPerFrame = 16;
+
+	/* Time budget per frame for this pool during the prewarm pass.  0 disables the time limit */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Budget", meta = (ClampMin = "0", UIMin = "0", Units = "ms"))
+	float PrewarmMillisecondsPerFrame = 2.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling")
+	bool bKeepAcrossSeamlessTravel = false;
+};
+
+/**
+ * Data driven list of shared pools.  UObjectPoolSubsystem prewarms every pool in it, highest priority first and one pool at a time,
+ * when the world begins play if the config is listed in the Dynamic Object Pooler project settings.
+ */
+UCLASS(BlueprintType)
+class DYNAMICOBJECTPOOLER_API UObjectPoolConfig : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling", meta = (TitleProperty = "ActorClass"))
+	TArray<FObjectPoolDefinition> Pools;
+
+	/* Primary asset type of every config, registered with the asset manager by the module */
+	static const FPrimaryAssetType PrimaryAssetType;
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+#if WITH_EDITOR
+	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+#endif
+};
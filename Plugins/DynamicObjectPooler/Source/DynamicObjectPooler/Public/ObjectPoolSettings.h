@@ -0,0 +1,26 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "ObjectPoolSettings.generated.h"
+
+class UObjectPoolConfig;
+
+/**
+ * Project settings for the Dynamic Object Pooler.  Found under Project Settings > Plugins.
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Dynamic Object Pooler"))
+class DYNAMICOBJECTPOOLER_API UObjectPoolSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	UObjectPoolSettings();
+
+	/* Pool configs prewarmed by every server and standalone world when it begins play */
+	UPROPERTY(Config, EditAnywhere, Category = "Dynamic Object Pooling")
+	TArray<TSoftObjectPtr<UObjectPoolConfig>> StartupPoolConfigs;
+};
@@ -0,0 +1,110 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ObjectPoolConfig.h"
+#include "ObjectPoolSubsystem.generated.h"
+
+class UObjectPoolingComponent;
+struct FStreamableHandle;
+
+/**
+ * Replicated actor that carries the shared pool components for the world.  Spawned on demand by UObjectPoolSubsystem.
+ */
+UCLASS(NotBlueprintable, Transient)
+class DYNAMICOBJECTPOOLER_API AObjectPoolHost : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+
+	AObjectPoolHost();
+};
+
+/**
+ * Owns one shared pool per actor class for the world.  Components with bUseSharedPool forward to these pools
+ * so owners pooling the same class no longer keep duplicate reserves.
+ *
+ * The pools live on a host in the persistent level, so streaming sublevels in and out never rebuilds them.  Pools with
+ * bKeepAcrossSeamlessTravel move to the next map together with their idle actors when the game mode calls AddSeamlessTravelActors.
+ */
+UCLASS()
+class DYNAMICOBJECTPOOLER_API UObjectPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/* Spawns an actor of the class from its shared pool, creating the pool on first use.  Server only */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic Object Pooling", meta = (DeterminesOutputType = "ActorClass"))
+	AActor* Acquire(TSubclassOf<AActor> ActorClass, const FTransform& SpawnTransform);
+
+	/* Returns an actor to the shared pool of its class */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic Object Pooling")
+	void Release(AActor* Actor);
+
+	/* Returns the shared pool for the class if one exists */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Object Pooling")
+	UObjectPoolingComponent* FindPool(TSubclassOf<AActor> ActorClass) const;
+
+	/* Returns the shared pool for the class, creating it if needed.  The pool is grown so it holds at least InitialSize actors,
+	 * 0 or less uses the pool's InitialPoolSize.  Settings is used to configure a newly created pool */
+	UObjectPoolingComponent* FindOrCreatePool(TSubclassOf<AActor> ActorClass, int32 InitialSize = 0, const UObjectPoolingComponent* Settings = nullptr, bool bPrewarmAsync = false);
+
+	/* Loads the class asynchronously and grows its shared pool to Count actors over several frames.  Call it when a streaming level
+	 * or travel starts loading so its pools are warm by the time the level is visible.  Server only */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic Object Pooling")
+	void PrewarmPool(TSoftClassPtr<AActor> ActorClass, int32 Count);
+
+	/* Queues every pool in the config for prewarming.  Classes load in one async request and pools prewarm one at a time,
+	 * highest priority first, each within its own frame budget.  Server only */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic Object Pooling")
+	void PrewarmFromConfig(const UObjectPoolConfig* Config);
+
+	/* Call from AGameModeBase::GetSeamlessTravelActorList after adding the game's own actors.  Adds the pool host and the idle actors
+	 * of every pool with bKeepAcrossSeamlessTravel whose owner travels, and drops the shared pools that do not travel */
+	static void AddSeamlessTravelActors(UWorld* World, TArray<AActor*>& ActorList);
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+private:
+
+	/* Spawns the host actor for the shared pool components if it does not exist yet */
+	AObjectPoolHost* GetOrSpawnHost();
+
+	/* Takes over a host and its pools carried over from the previous map by seamless travel */
+	void AdoptTravelledHost();
+
+	/* Creates an unconfigured shared pool for the class on the host */
+	UObjectPoolingComponent* CreatePool(TSubclassOf<AActor> ActorClass);
+
+	/* Starts prewarming the next config pool once the current one is done */
+	void PrewarmNextConfigPool();
+
+	/* Bound to the config pool currently prewarming */
+	UFUNCTION()
+	void HandleConfigPoolPrewarmed();
+
+	/* Config pools still to prewarm, sorted by ascending priority */
+	TArray<FObjectPoolDefinition> PendingDefinitions;
+
+	/* Config pool currently prewarming, the next one waits until it is done */
+	UPROPERTY(Transient)
+	UObjectPoolingComponent* PrewarmingConfigPool = nullptr;
+
+	/* Async loads started by PrewarmPool, released once the class is loaded */
+	TArray<TSharedPtr<FStreamableHandle>> PrewarmLoadHandles;
+
+	UPROPERTY(Transient)
+	AObjectPoolHost* PoolHost;
+
+	/* One shared pool per pooled class */
+	UPROPERTY(Transient)
+	TMap<TSubclassOf<AActor>, UObjectPoolingComponent*> SharedPools;
+};
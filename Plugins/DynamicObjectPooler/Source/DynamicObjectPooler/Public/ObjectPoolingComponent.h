@@ -5,22 +5,156 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Components/ActorComponent.h"
+#include "Engine/StreamableManager.h"
+#include "Async/Future.h"
+#include "Containers/Queue.h"
+#include <atomic>
 #include "ObjectPoolingComponent.generated.h"
 
+class IPooledActorInterface;
+class UPrimitiveComponent;
+class UPooledActorCluster;
+struct FObjectPoolDefinition;
+
+/* How pooled actors are kept in sync with clients while they move in and out of the pool */
+UENUM(BlueprintType)
+enum class EPooledReplicationPolicy : uint8
+{
+	/* Replication is switched off while pooled and back on when reused.  Opens and closes an actor channel on every reuse */
+	ToggleReplication,
+
+	/* The actor channel stays open and pooled actors go dormant.  Reuse wakes the actor and only sends a small delta, the replicated hidden flag acts as the active bit */
+	Dormancy,
+
+	/* Replication stays on for the lifetime of the pool and UReplicationGraphNode_PooledActors only gathers active actors.
+	 * Idle actors cost nothing in relevancy and reuse causes no graph changes.  Requires the node, from the DynamicObjectPoolerReplication module, in the game's replication graph */
+	ReplicationGraph
+};
+
+/* How many actors the pool adds when it runs dry with bAutoExpand on */
+UENUM(BlueprintType)
+enum class EPoolGrowthMode : uint8
+{
+	/* Add one actor per empty request */
+	Single,
+
+	/* Add GrowthChunkSize actors at once */
+	FixedChunk,
+
+	/* Grow the pool by GrowthFactor of its current size */
+	Geometric,
+
+	/* Grow to the largest peak seen so far scaled by GrowthFactor */
+	PredictedPeak
+};
+
+/* Where actors are moved when they return to the pool */
+UENUM(BlueprintType)
+enum class EPooledActorParking : uint8
+{
+	/* Leave the actor where it was returned.  Avoids dirtying render and physics state for the move */
+	None,
+
+	/* Move the actor to the world origin */
+	Origin,
+
+	/* Move the actor to ParkingLocation, usually far outside the playable space */
+	ParkingLocation
+};
+
+/* How much of a pooled actor's scene state is torn down while it sits in the pool */
+UENUM(BlueprintType)
+enum class EPooledActorSleepMode : uint8
+{
+	/* Hide the actor and disable collision only.  Physics bodies and render proxies stay in their scenes */
+	None,
+
+	/* Simulating bodies are put to sleep and made kinematic, then simulate again on reuse.  Render proxies stay registered */
+	SleepPhysics,
+
+	/* Primitive components are unregistered, removing their physics bodies and render proxies entirely.  They are registered again on reuse */
+	UnregisterPrimitives
+};
+
+/* Which active actor is recycled when the pool is exhausted and cannot grow */
+UENUM(BlueprintType)
+enum class EPooledEvictionPolicy : uint8
+{
+	/* Spawns fail while the pool is exhausted */
+	None,
+
+	/* Return the actor that has been active the longest */
+	OldestFirst,
+
+	/* Return the actor with the lowest IPooledActorInterface eviction priority */
+	LowestPriority,
+
+	/* Return the actor farthest from every player's view */
+	FurthestFromViewers
+};
+
 // Used for when an actor is spawned from the pool
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPooledActorSpawned, AActor*, Actor);
 
 // Used for when an actor is returned to the pool
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPooledActorReturned, AActor*, Actor);
 
+// Used for when a batch of actors is spawned from the pool
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPooledActorsSpawned, const TArray<AActor*>&, Actors);
+
+// Used for when a batch of actors is returned to the pool
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPooledActorsReturned, const TArray<AActor*>&, Actors);
+
 // Delegate for notifying when the pool is initialized
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPoolInitialized);
 
+// Used for when a client predicted actor is matched with the server's actor, or times out with a null AuthoritativeActor
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPredictedActorReconciled, AActor*, PredictedActor, AActor*, AuthoritativeActor);
+
+// Used for when an actor pooled with the ReplicationGraph policy is activated or returned
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnPooledActorActivityChanged, AActor* /*Actor*/, bool /*bActive*/);
+
+/* Tells the owning client which replicated actor the server spawned for one of its predictions */
+USTRUCT()
+struct FPooledPredictionHandoff
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 PredictionId = INDEX_NONE;
+
+	UPROPERTY()
+	AActor* Actor = nullptr;
+};
+
+/* Reference to an actor handed out by a pool.  Resolves to null once the actor has been returned, even if its slot was reused since,
+ * so holding on to a handle is safe where holding on to the actor is not.  Only valid with the component that issued it */
+USTRUCT(BlueprintType)
+struct FPooledActorHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 SlotIndex = INDEX_NONE;
+
+	UPROPERTY()
+	uint32 Generation = 0;
+
+	/* True if the handle was ever issued.  Use ResolveHandle to know whether the actor is still out */
+	bool IsSet() const { return SlotIndex != INDEX_NONE; }
+
+	bool operator==(const FPooledActorHandle& Other) const { return SlotIndex == Other.SlotIndex && Generation == Other.Generation; }
+	bool operator!=(const FPooledActorHandle& Other) const { return !(*this == Other); }
+};
+
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class DYNAMICOBJECTPOOLER_API UObjectPoolingComponent : public UActorComponent
 {
 	GENERATED_BODY()
 
+	// The automation tests step lifespans and the async prewarm directly
+	friend struct FObjectPoolTestAccess;
+
 public:	
 
 	UObjectPoolingComponent();
@@ -37,34 +171,285 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Dynamic Object Pooling")
 	void InitializePool(TSubclassOf<AActor> ActorClass, int32 InitialSize);
 
+	/* Initializes the pool over several frames.  The class is loaded asynchronously first, then actors are spawned within the prewarm budget.
+	 * OnPoolInitialized fires once the last actor is spawned.  An InitialSize of 0 or less uses InitialPoolSize */
+	UFUNCTION(BlueprintCallable, Category="Dynamic Object Pooling")
+	void InitializePoolAsync(TSoftClassPtr<AActor> ActorClass, int32 InitialSize = 0);
+
+	/* True while an async prewarm is still loading the class or spawning actors */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Object Pooling")
+	bool IsPrewarming() const { return SharedPool ? SharedPool->IsPrewarming() : bNotifyWhenPrewarmed || PrewarmLoadHandle.IsValid(); }
+
+	/* Live actors plus those an initialization prewarm in flight will still add, including one waiting on its class load */
+	int32 GetPrewarmTargetSize() const;
+
+	/* Adds actors to the initialization prewarm in flight, so OnPoolInitialized only fires once they are spawned too.  Does nothing without one */
+	void AddToPrewarm(int32 Count);
+
 	/* Used to spawn pooled actors over the engine method */
 	UFUNCTION(BlueprintCallable, Category = "Dynamic Object Pooling")
 	AActor* SpawnPooledActor(const FTransform& SpawnTransform);
 
+	/* Spawns a pooled actor and returns a handle to it instead of the actor.  The handle is unset if no actor was available */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic Object Pooling | Handles")
+	FPooledActorHandle SpawnPooledActorHandle(const FTransform& SpawnTransform);
+
+	/* Returns the actor a handle refers to, or null if it has been returned or destroyed since.  Constant time */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Object Pooling | Handles")
+	AActor* ResolveHandle(const FPooledActorHandle& Handle) const;
+
+	/* Returns the actor a handle refers to.  Stale handles are ignored, so this never returns an actor that has been reused.  Returns true if an actor was returned */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic Object Pooling | Handles")
+	bool ReleaseHandle(const FPooledActorHandle& Handle);
+
+	/* Makes a handle for an actor currently handed out by this pool, or an unset handle if it is not */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Object Pooling | Handles")
+	FPooledActorHandle GetActorHandle(const AActor* Actor) const;
+
+	/* Thread safe.  Queues a spawn from any thread, such as an AI or ballistics task.  Queued requests are served in one batch on the game thread
+	 * during the pool's next tick, and the future is then fulfilled with the handle, unset if no actor was available.  Resolve the handle on the
+	 * game thread.  The caller must keep the pool alive while it enqueues */
+	TFuture<FPooledActorHandle> EnqueueSpawnRequest(const FTransform& SpawnTransform);
+
+	/* Thread safe.  Queues the return of a handed out actor from any thread.  Served with the spawns, before them, so the slot can be reused in the same batch */
+	void EnqueueReturnRequest(const FPooledActorHandle& Handle);
+
+	/* Spawns one pooled actor per transform in a single pass.  Statistics and lifespans are handled once for the batch and
+	 * OnPooledActorsSpawned fires once instead of OnPooledActorSpawned per actor.  Returns the number of actors spawned */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic Object Pooling")
+	int32 SpawnPooledActors(const TArray<FTransform>& SpawnTransforms, TArray<AActor*>& OutActors);
+
+	/* Client side.  Spawns a cosmetic actor from the local mirror pool right away and returns the id to send to the server with the request.
+	 * The server spawns through SpawnPooledActorForPrediction and the predicted actor is returned once the server's actor replicates.
+	 * The predicted actor belongs to the prediction until then, do not return it yourself.  With authority this is a normal spawn and OutPredictionId is INDEX_NONE */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic Object Pooling | Prediction")
+	AActor* SpawnPredictedActor(const FTransform& SpawnTransform, int32& OutPredictionId);
+
+	/* Server side.  Spawns a pooled actor for a client prediction and hands it to the owning client for reconciliation */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic Object Pooling | Prediction")
+	AActor* SpawnPooledActorForPrediction(const FTransform& SpawnTransform, int32 PredictionId);
+
+	/* Client side.  Creates and fills the local mirror pool ahead of the first predicted spawn */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic Object Pooling | Prediction")
+	void InitializeMirrorPool();
+
+	/* Returns a batch of actors to the pool.  OnPooledActorsReturned fires once instead of OnPooledActorReturned per actor */
+	UFUNCTION(BlueprintCallable, Category = "Dynamic Object Pooling")
+	void ReturnObjectsToPool(const TArray<AActor*>& Actors);
+
 	// Get the current number of pooled objects
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Pooling")
-	int32 GetTotalObjectsCreated() const { return TotalObjectsCreated; }
+	int32 GetTotalObjectsCreated() const { return SharedPool ? SharedPool->GetTotalObjectsCreated() : TotalObjectsCreated; }
+
+	// Get the number of live actors held by the pool, both active and inactive
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Pooling")
+	int32 GetNumPooledActors() const { return SharedPool ? SharedPool->GetNumPooledActors() : Pool.Num() - DeadSlots.Num(); }
+
+	// Get every actor currently handed out by the pool.  Scans the slot bits instead of the actors
+	UFUNCTION(BlueprintCallable, Category = "Pooling")
+	void GetActiveActors(TArray<AActor*>& OutActors) const;
+
+	// Get the size used when the pool is initialized without an explicit size
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Pooling")
+	int32 GetInitialPoolSize() const { return InitialPoolSize; }
+
+	/* The class this pool spawns, null until the pool is initialized */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Object Pooling")
+	TSubclassOf<AActor> GetPooledObjectClass() const { return SharedPool ? SharedPool->GetPooledObjectClass() : PooledObjectClass; }
+
+	/* The shared pool this component forwards to, or null when it owns its own pool */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Object Pooling")
+	UObjectPoolingComponent* GetSharedPool() const { return SharedPool; }
+
+	/* Copies the pooling configuration, not the pool contents, from another component.  Used to set up shared pools */
+	void CopyPoolSettingsFrom(const UObjectPoolingComponent* Source);
+
+	/* Applies the growth, sizing, lifespan, prewarm and travel settings of a UObjectPoolConfig entry.  Safe on a pool that is already running */
+	void ApplyPoolDefinition(const FObjectPoolDefinition& Definition);
+
+	/* Returns every active actor and adds the pooled actors to a seamless travel actor list.  Called by UObjectPoolSubsystem::AddSeamlessTravelActors */
+	void PrepareForSeamlessTravel(TArray<AActor*>& ActorList);
+
+	/* Fires for every pool using the ReplicationGraph policy.  Lets replication graph nodes gate pooled actors on the active bit */
+	static FOnPooledActorActivityChanged OnPooledActorActivityChanged;
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Dynamic Object Pooling | Configuration")
 	bool bAutoExpand = false;
 
+	/* How many actors are added at once when the pool runs dry */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Dynamic Object Pooling | Configuration", meta = (EditCondition = "bAutoExpand"))
+	EPoolGrowthMode GrowthMode = EPoolGrowthMode::Single;
+
+	/* Actors added per growth with the FixedChunk growth mode */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Dynamic Object Pooling | Configuration", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bAutoExpand && GrowthMode == EPoolGrowthMode::FixedChunk"))
+	int32 GrowthChunkSize = 8;
+
+	/* Multiplier used by the Geometric and PredictedPeak growth modes */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Dynamic Object Pooling | Configuration", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bAutoExpand && GrowthMode != EPoolGrowthMode::Single && GrowthMode != EPoolGrowthMode::FixedChunk"))
+	float GrowthFactor = 1.5f;
+
+	/* When the pool runs dry, return null for the request and finish the growth over the next frames within the prewarm budget
+	 * instead of spawning on the spot */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Dynamic Object Pooling | Configuration", meta = (EditCondition = "bAutoExpand"))
+	bool bDeferredOverflow = false;
+
+	/* Keeps the pool and its idle actors across seamless travel when its owner travels.  Shared pools created with this setting travel on the pool host.
+	 * Requires the game mode to call UObjectPoolSubsystem::AddSeamlessTravelActors */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Dynamic Object Pooling | Configuration")
+	bool bKeepAcrossSeamlessTravel = false;
+
+	/* Pools through the world's UObjectPoolSubsystem so every component using the same class shares one reserve.
+	 * This component then only forwards requests, and its delegates fire for the actors it spawned.  Set before the pool is initialized */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Dynamic Object Pooling | Configuration")
+	bool bUseSharedPool = false;
+
 	UPROPERTY(BlueprintAssignable, Category = "Dynamic Object Pooling | Delegates")
 	FOnPooledActorSpawned OnPooledActorSpawned;
 
 	UPROPERTY(BlueprintAssignable, Category = "Dynamic Object Pooling | Delegates")
 	FOnPooledActorReturned OnPooledActorReturned;
 
+	UPROPERTY(BlueprintAssignable, Category = "Dynamic Object Pooling | Delegates")
+	FOnPooledActorsSpawned OnPooledActorsSpawned;
+
+	UPROPERTY(BlueprintAssignable, Category = "Dynamic Object Pooling | Delegates")
+	FOnPooledActorsReturned OnPooledActorsReturned;
+
 	UPROPERTY(BlueprintAssignable, Category = "Dynamic Object Pooling | Delegates")
 	FOnPoolInitialized OnPoolInitialized;
 
+	UPROPERTY(BlueprintAssignable, Category = "Dynamic Object Pooling | Delegates")
+	FOnPredictedActorReconciled OnPredictedActorReconciled;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling")
 	float ActorLifespan;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Configuration")
 	bool bUseTimerLifespan = true;
 
+	/* Only used without the timer lifespan.  Lifespan expiry, including the class Initial Life Span, returns the actor to the pool instead of destroying it.
+	 * When off, actors destroy themselves and their slots are recycled by the next expansion */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Configuration", meta = (EditCondition = "!bUseTimerLifespan"))
+	bool bInterceptDestroy = true;
+
+	/* Where actors are moved when they return to the pool.  Actors implementing DeactivatePooledActor can skip this themselves */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Configuration")
+	EPooledActorParking ParkingMode = EPooledActorParking::Origin;
+
+	/* Location used by the ParkingLocation parking mode */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Configuration", meta = (EditCondition = "ParkingMode == EPooledActorParking::ParkingLocation"))
+	FVector ParkingLocation = FVector(0.0, 0.0, -100000.0);
+
+	/* Deep sleep for idle actors so the physics and render scenes only pay for active ones.  Actors implementing DeactivatePooledActor skip this too */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Configuration")
+	EPooledActorSleepMode SleepMode = EPooledActorSleepMode::None;
+
+	/* Groups idle actors into GC clusters by chunk of slots, so garbage collection skips their reference graphs.  The pooled class
+	 * needs Can Be In Cluster enabled, and idle actors must not change their object references while pooled */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Garbage Collection")
+	bool bClusterIdleActors = false;
+
+	/* Slots per cluster.  Reusing an actor dissolves only its own chunk's cluster.  Must be set before the pool is initialized */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Garbage Collection", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bClusterIdleActors"))
+	int32 IdleClusterSize = 64;
+
+	/* How long a chunk has to stay fully idle before it is clustered */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Garbage Collection", meta = (ClampMin = "0", UIMin = "0", Units = "s", EditCondition = "bClusterIdleActors"))
+	float IdleClusterDelay = 10.f;
+
+	/* Keeps a free list per grid cell and reuses the idle actor nearest to the spawn location, so reuse is a short move instead of
+	 * a teleport across the world.  Cells come from where actors were returned, so use it with the None parking mode.  Must be set before the pool is initialized */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Spatial")
+	bool bSpatialReuse = false;
+
+	/* Size of a grid cell on the horizontal plane */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Spatial", meta = (ClampMin = "100", UIMin = "100", Units = "cm", EditCondition = "bSpatialReuse"))
+	float SpatialCellSize = 5000.f;
+
+	/* Rings of neighbouring cells searched before any free actor is taken.  0 only checks the spawn location's cell */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Spatial", meta = (ClampMin = "0", UIMin = "0", UIMax = "4", EditCondition = "bSpatialReuse"))
+	int32 SpatialSearchRings = 1;
+
+	/* Active actors farther than this from every player's view are returned early.  0 disables it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Spatial", meta = (ClampMin = "0", UIMin = "0", Units = "cm"))
+	float ReturnDistance = 0.f;
+
+	/* How often active actors are checked against ReturnDistance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Spatial", meta = (ClampMin = "0.1", UIMin = "0.1", Units = "s", EditCondition = "ReturnDistance > 0"))
+	float ReturnDistanceInterval = 1.f;
+
+	/* Force-returns an active actor and reuses it when the pool is exhausted and cannot grow, so a hard MaxPoolSize does not drop spawns.
+	 * Evicted actors fire OnPooledActorReturned like any other return.  Must be set before the pool is initialized */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Eviction")
+	EPooledEvictionPolicy EvictionPolicy = EPooledEvictionPolicy::None;
+
+	/* How old the distance ordering of FurthestFromViewers may get before an eviction recomputes it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Eviction", meta = (ClampMin = "0", UIMin = "0", Units = "s", EditCondition = "EvictionPolicy == EPooledEvictionPolicy::FurthestFromViewers"))
+	float EvictionRefreshInterval = 0.25f;
+
+	/* How pooled actors replicate while they are in and out of the pool.  Must be set before the pool is initialized */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Replication")
+	EPooledReplicationPolicy ReplicationPolicy = EPooledReplicationPolicy::ToggleReplication;
+
+	/* Lets the owning client spawn predicted actors from a local, non-replicated mirror pool.  Must be set before the pool is initialized */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Prediction")
+	bool bClientPrediction = false;
+
+	/* Cosmetic class spawned by the mirror pool.  Uses the pooled class when not set */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Prediction", meta = (EditCondition = "bClientPrediction"))
+	TSubclassOf<AActor> PredictedActorClass;
+
+	/* Actors spawned into the mirror pool when it is created.  It grows on demand after that */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Prediction", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bClientPrediction"))
+	int32 MirrorPoolSize = 8;
+
+	/* Predicted actors the server has not confirmed within this time are returned to the mirror pool */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Prediction", meta = (ClampMin = "0", UIMin = "0", Units = "s", EditCondition = "bClientPrediction"))
+	float PredictionTimeout = 1.f;
+
+	/* Max actors spawned per frame while prewarming asynchronously */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Prewarm", meta = (ClampMin = "1", UIMin = "1"))
+	int32 PrewarmActorsPerFrame = 16;
+
+	/* Spawns pooled actors as copies of one idle template actor instead of the class defaults, so state the construction script computes
+	 * is copied rather than recomputed from scratch.  The template is never handed out.  Construction scripts and BeginPlay still run on every copy */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Prewarm")
+	bool bCloneFromTemplate = false;
+
+	/* Time budget per frame while prewarming asynchronously.  At least one actor is always spawned per frame.  0 disables the time limit */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Prewarm", meta = (ClampMin = "0", UIMin = "0", Units = "ms"))
+	float PrewarmMillisecondsPerFrame = 2.f;
+
+	/* Grows the pool ahead of demand and destroys surplus idle actors, driven by a decaying high water mark of active actors */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Sizing")
+	bool bAdaptiveSizing = false;
+
+	/* Adaptive sizing never shrinks the pool below this many live actors, nor below the size reserved through InitializePool */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Sizing", meta = (ClampMin = "0", UIMin = "0"))
+	int32 MinPoolSize = 0;
+
+	/* Hard cap on live actors for every kind of growth.  0 means unlimited */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Sizing", meta = (ClampMin = "0", UIMin = "0"))
+	int32 MaxPoolSize = 0;
+
+	/* Time for the tracked high water mark to decay halfway back towards the current demand */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Sizing", meta = (ClampMin = "0", UIMin = "0", Units = "s", EditCondition = "bAdaptiveSizing"))
+	float DemandHalfLife = 30.f;
+
+	/* Extra fraction of the high water mark kept ready as idle actors */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Sizing", meta = (ClampMin = "0", UIMin = "0", EditCondition = "bAdaptiveSizing"))
+	float AdaptiveHeadroom = 0.25f;
+
+	/* Minimum number of actors added when the pool grows ahead of demand.  Growth is spread over frames with the prewarm budget */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Sizing", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bAdaptiveSizing"))
+	int32 AdaptiveGrowthChunk = 8;
+
+	/* Max surplus idle actors destroyed per frame when shrinking */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Dynamic Object Pooling | Sizing", meta = (ClampMin = "0", UIMin = "0", EditCondition = "bAdaptiveSizing"))
+	int32 ShrinkActorsPerFrame = 2;
+
 	
 	/* Pooling Statistics Variables */
 
@@ -72,12 +457,12 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
 	int32 TotalObjectsCreated = 0;
 
-	/* */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
+	/* Replicated so clients can read pool pressure without the pool array itself being replicated */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Replicated, Category = "Dynamic Object Pooling | Pooling Statistics")
 	int32 ActiveObjects = 0;
 
-	/* */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
+	/* Replicated so clients can read pool pressure without the pool array itself being replicated */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Replicated, Category = "Dynamic Object Pooling | Pooling Statistics")
 	int32 InactiveObjects = 0;
 
 	/* */
@@ -96,9 +481,32 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
 	int32 PeakUsage = 0;
 
+	/* Active actors force-returned by the eviction policy */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
+	int32 TotalEvictions = 0;
+
+	/* Acquires served straight from an idle actor */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
+	int32 TotalPoolHits = 0;
+
+	/* Acquires that had to grow the pool, evict an actor, or failed */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
+	int32 TotalPoolMisses = 0;
+
+	/* Acquire time in microseconds below which the given fraction of acquires finished, such as 0.95.  Growth is included.
+	 * Kept as a power of two histogram, so the result is the upper edge of a bucket.  Always 0 in shipping builds, which skip the timing */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Object Pooling | Pooling Statistics")
+	float GetAcquireLatencyPercentile(float Percentile) const;
+
+	/* High water mark of active actors that decays over DemandHalfLife.  Drives adaptive sizing */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dynamic Object Pooling | Pooling Statistics")
+	float DecayedPeakUsage = 0.f;
+
 protected:
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	
 	// RPC to notify clients when the pool is ready
 	UFUNCTION(NetMulticast, Reliable)
@@ -114,23 +522,404 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Dynamic Object Pooling", meta = (AllowPrivateAccess = "true"))
 	TSubclassOf<AActor> PooledObjectClass;
 
-	/* The array of actors that will be used to pull from and return to */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Replicated, Category="Dynamic Object Pooling", meta = (AllowPrivateAccess = "true"))
+	/* The array of actors that will be used to pull from and return to.  Server only, the pooled actors replicate on their own */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Dynamic Object Pooling", meta = (AllowPrivateAccess = "true"))
 	TArray<AActor*> Pool;
 
-	/* How large the pool you wish to set aside in memory */
+	/* Class the mirror pool falls back to.  Replicated so clients know it, also when this component forwards to a shared pool */
+	UPROPERTY(Replicated)
+	TSubclassOf<AActor> PredictionClass;
+
+	/* Client local pool of predicted actors, created on the first predicted spawn */
+	UPROPERTY(Transient)
+	UObjectPoolingComponent* MirrorPool = nullptr;
+
+	/* Set on a mirror pool.  It is managed locally on the client and its actors never replicate */
+	bool bLocalOnly = false;
+
+	/* Server to owning client list of the latest predicted spawns.  Actor references resolve once the actors replicate */
+	UPROPERTY(ReplicatedUsing = OnRep_PredictionHandoffs)
+	TArray<FPooledPredictionHandoff> PredictionHandoffs;
+
+	/* Predicted actor waiting for the server's actor */
+	struct FPendingPrediction
+	{
+		int32 PredictionId;
+		TWeakObjectPtr<AActor> Actor;
+		double ExpiryTime;
+	};
+
+	/* Predictions this client is still waiting on, oldest first */
+	TArray<FPendingPrediction> PendingPredictions;
+
+	/* Id handed out with the next predicted spawn */
+	int32 NextPredictionId = 1;
+
+	/* Matches replicated handoffs with pending predictions */
+	UFUNCTION()
+	void OnRep_PredictionHandoffs();
+
+	/* Returns a predicted actor to the mirror pool and notifies listeners */
+	void ReconcilePrediction(int32 PendingIndex, AActor* AuthoritativeActor);
+
+	/* Returns predicted actors the server never confirmed */
+	void ProcessPredictionTimeouts();
+
+	/* The world subsystem pool this component forwards to when bUseSharedPool is set */
+	UPROPERTY(Transient)
+	UObjectPoolingComponent* SharedPool = nullptr;
+
+	/* Component that requested each slot's current spawn when this is a shared pool.  Its delegates are notified alongside this pool's */
+	TArray<TWeakObjectPtr<UObjectPoolingComponent>> SlotRequesters;
+
+	/* Spawn queued from another thread */
+	struct FQueuedSpawnRequest
+	{
+		FTransform SpawnTransform;
+		TPromise<FPooledActorHandle> Promise;
+	};
+
+	/* Requests from any thread, consumed only on the game thread */
+	TQueue<FQueuedSpawnRequest, EQueueMode::Mpsc> QueuedSpawnRequests;
+	TQueue<FPooledActorHandle, EQueueMode::Mpsc> QueuedReturnRequests;
+
+	/* Set by the first request after a drain, which asks the game thread to enable the tick */
+	std::atomic<bool> bQueuedRequestsPending = false;
+
+	/* Lets the game thread know there are queued requests to drain */
+	void ScheduleQueuedRequestDrain();
+
+	/* Serves every queued return and spawn.  Without bCanSpawn the spawns fail with an unset handle, used once the pool stops playing */
+	void DrainQueuedRequests(bool bCanSpawn = true);
+
+	/* Forwards the shared pool being ready to this component's listeners */
+	UFUNCTION()
+	void HandleSharedPoolInitialized();
+
+	/* Waits for the shared pool to finish prewarming, or notifies right away when it is ready */
+	void BindSharedPoolInitialized();
+
+	/* Spawns an actor on behalf of a requesting component.  Requester is null when spawning for this component */
+	AActor* SpawnPooledActorInternal(const FTransform& SpawnTransform, UObjectPoolingComponent* Requester, FPooledActorHandle* OutHandle = nullptr);
+
+	/* Batch version of SpawnPooledActorInternal */
+	int32 SpawnPooledActorsInternal(const TArray<FTransform>& SpawnTransforms, TArray<AActor*>& OutActors, UObjectPoolingComponent* Requester);
+
+	/* Returns an actor to this component's own pool.  Returns false for double returns and actors it does not own */
+	bool ReturnObjectToPoolInternal(AActor* Actor);
+
+	/* Batch version of ReturnObjectToPoolInternal.  Returns how many actors were accepted */
+	int32 ReturnObjectsToPoolInternal(const TArray<AActor*>& Actors);
+
+	/* How large the pool you wish to set aside in memory.  Grows to the largest total asked for across InitializePool calls and shared pool top-ups */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Dynamic Object Pooling", meta = (AllowPrivateAccess = "true"))
 	int32 PoolSize = 0;
 
-	// Server-only management of the pool
-	bool IsServer() const { return GetOwner()->HasAuthority(); }
+	/* Stack of indices into Pool that are free to be handed out.  Acquire pops and release pushes so neither has to scan the pool.
+	 * Only changed through PushFreeSlot, RemoveFreeSlot and PopColdestFreeSlots, which keep the slot positions and spatial cells in step */
+	TArray<int32> FreeSlots;
+
+	/* Free slots of each grid cell when bSpatialReuse is set */
+	TMap<FIntPoint, TArray<int32>> SpatialFreeSlots;
+
+	/* Adds a slot to the free list, in the cell of the location its actor was returned at */
+	void PushFreeSlot(int32 SlotIndex, const FVector& Location);
+
+	/* Takes a slot out of the free list in constant time.  Does nothing when it is not free */
+	void RemoveFreeSlot(int32 SlotIndex);
+
+	/* Drops a free slot from its grid cell's list when bSpatialReuse is set */
+	void RemoveFromSpatialCell(int32 SlotIndex);
+
+	/* Takes the most recently freed slot */
+	int32 PopFreeSlot();
+
+	/* Takes up to Count of the least recently freed slots, keeping the order of the rest */
+	void PopColdestFreeSlots(int32 Count, TArray<int32, TInlineAllocator<16>>& OutSlots);
+
+	/* Takes a free slot in or near the cell of a location, or the most recently freed one when there is none nearby */
+	int32 PopNearestFreeSlot(const FVector& Location);
+
+	/* Grid cell holding a location */
+	FIntPoint GetSpatialCell(const FVector& Location) const;
+
+	/* Runs the return distance check while ReturnDistance is set */
+	FTimerHandle ReturnDistanceTimer;
+
+	/* Returns active actors that are farther than ReturnDistance from every viewer */
+	void ReturnDistantActors();
+
+	/* View locations of every local and remote player */
+	void GetViewerLocations(TArray<FVector>& OutLocations) const;
+
+	/* Per slot state is kept in compact arrays parallel to Pool, so scans, expiry sweeps and stats never dereference the actors.
+	 * AddSlot is the single place that grows them */
+
+	/* One bit per slot in Pool, set while the actor is handed out.  This is the source of truth for availability instead of visibility */
+	TBitArray<> SlotInUse;
+
+	/* Bumped every time a slot's actor is returned or destroyed, so anything remembering an older generation knows it is stale */
+	TArray<uint32> SlotGenerations;
+
+	/* Position of each slot in FreeSlots, INDEX_NONE while it is not free */
+	TArray<int32> SlotFreeIndices;
+
+	/* Grid cell of each free slot and its position in the cell's list, INDEX_NONE while it is not in a cell */
+	TArray<FIntPoint> SlotCells;
+	TArray<int32> SlotCellIndices;
+
+	/* GC cluster of each chunk of IdleClusterSize slots, null while the chunk is not clustered */
+	UPROPERTY(Transient)
+	TArray<UPooledActorCluster*> ChunkClusters;
+
+	/* Last time a slot in each chunk was acquired or released */
+	TArray<double> ChunkLastUseTimes;
+
+	/* Runs the idle chunk check while bClusterIdleActors is set */
+	FTimerHandle IdleClusterTimer;
+
+	/* Clusters chunks that have been fully idle for IdleClusterDelay */
+	void ClusterIdleChunks();
+
+	/* Dissolves the cluster of the chunk holding a slot before its actor is used or changed */
+	void DissolveChunkCluster(int32 SlotIndex);
+
+	/* Dissolves every chunk cluster */
+	void DissolveAllChunkClusters();
+
+	/* Puts an actor in a free slot, recycling a dead slot if there is one.  Returns the slot index */
+	int32 AddSlot(AActor* Actor);
+
+	/* Reserves every per slot array for a number of new actors */
+	void ReserveSlots(int32 Count);
+
+	/* Maps each pooled actor to its slot in Pool so ownership checks are a single hashed lookup */
+	TMap<const AActor*, int32> SlotLookup;
+
+	/* Slots in Pool whose actor was destroyed.  ExpandPool refills these before growing the array */
+	TArray<int32> DeadSlots;
 
-	/* Used to expand the object pool ** Called in intialize and GetPooledObject */
-	void ExpandPool();
+	/* Lifespan the pooled class sets on itself through Initial Life Span.  It is cancelled on spawn and handled by the pool instead */
+	float ClassInitialLifeSpan = 0.f;
+
+	/* Releases a destroyed actor's slot so ExpandPool can recycle it */
+	void RemoveDeadSlot(int32 SlotIndex);
+
+	/* Updates the decaying high water mark and grows or shrinks the pool towards the adaptive target */
+	void TickAdaptiveSizing(float DeltaTime);
+
+	/* Live actor count adaptive sizing is aiming for */
+	int32 GetAdaptiveTargetSize() const;
+
+	/* True once the pool has reached MaxPoolSize */
+	bool IsAtMaxPoolSize() const { return MaxPoolSize > 0 && GetNumPooledActors() >= MaxPoolSize; }
+
+	/* Recalculates InactiveObjects from the live slot count and publishes the counters to Insights and the CSV profiler */
+	void UpdateInactiveObjects();
+
+	/* Counts this pool last contributed to the process wide Insights and CSV counters */
+	int32 ReportedActiveObjects = 0;
+	int32 ReportedInactiveObjects = 0;
+
+	/* Replaces this pool's contribution to the process wide counters */
+	void PublishPoolCounters(int32 Active, int32 Inactive);
+
+	/* Returns the slot index of the actor in Pool or INDEX_NONE if this pool does not own it */
+	int32 FindSlotIndex(const AActor* Actor) const;
+
+	// Server-only management of the pool.  A client mirror pool is managed locally
+	bool IsServer() const { return bLocalOnly || GetOwner()->HasAuthority(); }
+
+	/* Used to expand the object pool by a batch of actors ** Called in intialize and GetPooledObject */
+	void ExpandPool(int32 Count = 1);
+
+	/* Spawns a single actor into the pool.  Returns false if the spawn failed or the pool is at MaxPoolSize */
+	bool AddPooledActor();
+
+	/* Spawns an idle actor with deferred construction, so the pooled state is applied before its components register.
+	 * Copies Template instead of the class defaults when one is given */
+	AActor* SpawnIdleActor(AActor* Template);
+
+	/* Source of the copies when bCloneFromTemplate is set.  Idle, not part of the pool and never handed out */
+	UPROPERTY(Transient)
+	AActor* TemplateActor = nullptr;
+
+	/* Number of actors to add when the pool runs dry, based on GrowthMode */
+	int32 GetGrowthCount() const;
 
 	UPROPERTY()
 	FTransform InitialSpawnTransform;
 
+	/* Actors still to be spawned by an async initialization prewarm */
+	int32 PendingPrewarmCount = 0;
+
+	/* Actors still to be spawned by background growth.  Shares the prewarm budget but never counts as prewarming */
+	int32 PendingGrowthCount = 0;
+
+	/* Set while the pending actors belong to an initialization prewarm that should fire OnPoolInitialized */
+	bool bNotifyWhenPrewarmed = false;
+
+	/* Handle for the async load of the pooled class, valid until the load completes */
+	TSharedPtr<FStreamableHandle> PrewarmLoadHandle;
+
+	/* Actors the async prewarm queues once its class load completes, including any added by AddToPrewarm meanwhile */
+	int32 PrewarmLoadSize = 0;
+
+	/* Called once the pooled class has been loaded for an async prewarm */
+	void OnPrewarmClassLoaded(TSoftClassPtr<AActor> ActorClass, int32 InitialSize);
+
+	/* Spawns the next batch of prewarm actors within the per-frame budget */
+	void TickPrewarm();
+
+	/* Notifies the server and clients that the pool is ready */
+	void FinishPoolInitialization();
+
+	/* Sets up replication on a newly spawned pooled actor according to ReplicationPolicy */
+	void InitializeActorReplication(AActor* Actor) const;
+
+	/* Switches an actor's replication between its active and pooled state according to ReplicationPolicy */
+	void SetActorReplicationActive(AActor* Actor, bool bActive) const;
+
+	/* Pops a free slot and activates its actor.  Shared by GetPooledObject and SpawnPooledActor.  With bSpatialReuse, NearLocation picks a nearby idle actor.
+	 * Records the hit or miss and the acquire time.  Slots set in EvictionExcludedSlots are never evicted to serve the request */
+	AActor* AcquirePooledActor(int32& OutSlotIndex, const FVector* NearLocation = nullptr, const TBitArray<>* EvictionExcludedSlots = nullptr);
+
+	/* Does the work of AcquirePooledActor, growing the pool or evicting an actor when there is no idle one */
+	AActor* AcquireFreeSlot(int32& OutSlotIndex, const FVector* NearLocation, const TBitArray<>* EvictionExcludedSlots);
+
+	/* Acquire counts by elapsed time, bucket N holds acquires that took from 2^N up to 2^(N+1) nanoseconds */
+#if !UE_BUILD_SHIPPING
+	static constexpr int32 NumAcquireLatencyBuckets = 24;
+	TStaticArray<uint32, NumAcquireLatencyBuckets> AcquireLatencyBuckets = TStaticArray<uint32, NumAcquireLatencyBuckets>(InPlace, 0);
+#endif
+
+	/* Entry in the lifespan heap, ordered so the earliest expiry is on top */
+	struct FPooledLifespanEntry
+	{
+		double ExpiryTime;
+		int32 SlotIndex;
+
+		bool operator<(const FPooledLifespanEntry& Other) const { return ExpiryTime < Other.ExpiryTime; }
+	};
+
+	/* Pool owned min-heap of lifespans keyed by world time.  Replaces a timer per spawn and is drained once per tick */
+	TArray<FPooledLifespanEntry> LifespanHeap;
+
+	/* Eviction candidate, the lowest entry is evicted first */
+	struct FPooledEvictionEntry
+	{
+		double Key;
+		double ActivationTime;
+		int32 SlotIndex;
+		uint32 Generation;
+
+		bool operator<(const FPooledEvictionEntry& Other) const
+		{
+			return Key < Other.Key || (Key == Other.Key && ActivationTime < Other.ActivationTime);
+		}
+	};
+
+	/* Min-heap of active slots for the eviction policy.  Entries whose slot has been returned since carry an old generation and are skipped */
+	TArray<FPooledEvictionEntry> EvictionHeap;
+
+	/* When FurthestFromViewers last rebuilt the heap from viewer distances */
+	double EvictionHeapBuildTime = -1.0;
+
+	/* Adds an activated slot to the eviction heap, for the policies that are keyed at activation */
+	void PushEvictionCandidate(AActor* Actor, int32 SlotIndex);
+
+	/* Rebuilds the eviction heap from the current viewer distances */
+	void RebuildEvictionHeapByDistance();
+
+	/* True while the entry still refers to the same activation of its slot */
+	bool IsEvictionEntryValid(const FPooledEvictionEntry& Entry) const { return SlotInUse[Entry.SlotIndex] && SlotGenerations[Entry.SlotIndex] == Entry.Generation; }
+
+	/* Force-returns the policy's victim, skipping slots set in ExcludedSlots.  Returns true if a slot was freed */
+	bool EvictActor(const TBitArray<>* ExcludedSlots = nullptr);
+
+	/* Expiry time of each slot's current lifespan, 0 when none.  Heap entries that no longer match are stale and skipped */
+	TArray<double> SlotExpiryTimes;
+
+	/* Adds the same lifespan for every slot to the heap */
+	void ScheduleLifespans(TConstArrayView<int32> SlotIndices, float Lifespan);
+
+	/* Applies the configured lifespan mode to freshly spawned slots */
+	void ApplySpawnLifespans(TConstArrayView<int32> SlotIndices);
+
+	/* Resets, places and activates an acquired actor for a spawn */
+	void PrepareSpawnedActor(AActor* PooledActor, int32 SlotIndex, const FTransform& SpawnTransform, UObjectPoolingComponent* Requester);
+
+	/* Single activation pipeline for every reuse.  Resets the actor, applies the transform if one is given and enables it, unless the actor handles it itself */
+	void ActivatePooledActor(AActor* Actor, int32 SlotIndex, const FTransform* SpawnTransform);
+
+	/* Single deactivation pipeline for every return.  Disables and optionally parks the actor, unless the actor handles it itself */
+	void DeactivatePooledActor(AActor* Actor, int32 SlotIndex);
+
+	/* Primitives a slot's actor had torn down by SleepMode, so waking restores exactly those */
+	struct FPooledSleepState
+	{
+		EPooledActorSleepMode Mode = EPooledActorSleepMode::None;
+		TArray<TWeakObjectPtr<UPrimitiveComponent>> Components;
+	};
+
+	/* Deep sleep state of each slot.  The arrays keep their allocation so sleeping a reused slot does not allocate */
+	TArray<FPooledSleepState> SlotSleepStates;
+
+	/* Tears down the physics and render state of an idle actor according to SleepMode */
+	void SleepPooledActor(AActor* Actor, int32 SlotIndex);
+
+	/* Restores what SleepPooledActor tore down.  The transform is applied first so bodies are created in place instead of teleported */
+	void WakePooledActor(AActor* Actor, int32 SlotIndex, const FTransform* SpawnTransform);
+
+	/* How IPooledActorInterface calls reach the pooled class */
+	enum class EPooledInterfaceDispatch : uint8
+	{
+		/* The class does not implement the interface */
+		None,
+
+		/* Blueprint implementation or override, calls go through the reflected Execute_ thunks */
+		Reflected,
+
+		/* Implemented in C++ without Blueprint overrides, calls are direct virtual calls */
+		Native
+	};
+
+	/* Cached once per pooled class by CachePooledClassInterface */
+	EPooledInterfaceDispatch InterfaceDispatch = EPooledInterfaceDispatch::None;
+
+	/* Offset of the native interface inside the pooled class, valid with native dispatch */
+	SIZE_T NativeInterfaceOffset = 0;
+
+	/* Checks once whether the pooled class implements IPooledActorInterface and whether calls can skip ProcessEvent */
+	void CachePooledClassInterface();
+
+	/* Returns the native interface of a pooled actor, or null when calls must go through reflection */
+	IPooledActorInterface* GetNativeInterface(AActor* Actor) const;
+
+	/* Updates the spawn statistics for a number of spawned actors */
+	void RecordSpawnedActors(int32 Count);
+
+	/* Deactivates an actor and frees its slot without touching statistics or delegates.  Returns the slot or INDEX_NONE if it was not returned */
+	int32 ReleasePooledActor(AActor* Actor);
+
+	/* Slot based ReleasePooledActor.  Returns false for a slot that is not handed out */
+	bool ReleaseSlot(int32 SlotIndex);
+
+	/* Returns a slot's actor with statistics and delegates, the shared path of ReturnObjectToPool and handles */
+	bool ReturnSlotToPool(int32 SlotIndex);
+
+	/* Returns every actor whose lifespan has run out in one batch */
+	void ProcessExpiredLifespans();
+
+	/* Time the last hot path warning was logged */
+	double LastPoolWarningTime = -DBL_MAX;
+
+	/* Rate limits warnings that can fire on every request, such as the pool running dry */
+	bool ShouldLogPoolWarning();
+
+	/* Enables ticking only while the component has per-frame work to do */
+	void RefreshTickEnabled();
+
 	UFUNCTION()
 	void HandleDestroyedActor(AActor* DestroyedActor);
 	
@@ -14,12 +14,30 @@ class UPooledActorInterface : public UInterface
 };
 
 /**
- * 
+ * Lets pooled actors, and components or objects pooled by UObjectInstancePoolingComponent, reset and toggle themselves on reuse
  */
 class DYNAMICOBJECTPOOLER_API IPooledActorInterface
 {
 	GENERATED_BODY()
 public:
+	/* Called once when a pool creates the actor, while its spawn is deferred and before the construction script and BeginPlay run.
+	 * Set a flag here to skip setup a hidden pooled actor does not need, and do it in ActivatePooledActor instead */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category="Dynamic Object Pooling")
+	void PreparePooledActor();
+
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category="Dynamic Object Pooling")
 	void ResetPooledActor();
+
+	/* Called when the actor leaves the pool, after ResetPooledActor.  Return true if the actor applied the transform and enabled
+	 * visibility, collision and tick itself, for example by only toggling collision on its root primitive.  The pool then skips its own defaults */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category="Dynamic Object Pooling")
+	bool ActivatePooledActor(const FTransform& SpawnTransform);
+
+	/* Called when the actor returns to the pool.  Return true if the actor disabled itself and the pool should skip hiding, disabling and parking it */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category="Dynamic Object Pooling")
+	bool DeactivatePooledActor();
+
+	/* Read when the actor is activated, used by the LowestPriority eviction policy.  Lower values are evicted first, ties go to the oldest actor */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category="Dynamic Object Pooling")
+	float GetPooledActorEvictionPriority() const;
 };
@@ -0,0 +1,29 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+using UnrealBuildTool;
+
+public class DynamicObjectPoolerReplication : ModuleRules
+{
+	public DynamicObjectPoolerReplication(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// Replication graph support lives in its own module, so only projects that use a replication graph need the plugin enabled
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"ReplicationGraph",
+			}
+			);
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"DynamicObjectPooler",
+			}
+			);
+	}
+}
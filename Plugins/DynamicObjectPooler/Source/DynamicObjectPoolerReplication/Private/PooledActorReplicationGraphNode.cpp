@@ -0,0 +1,96 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+
+#include "PooledActorReplicationGraphNode.h"
+#include "ObjectPoolingComponent.h"
+
+UReplicationGraphNode_PooledActors::UReplicationGraphNode_PooledActors()
+{
+	// Retired actors are flushed at the start of each replication frame
+	bRequiresPrepareForReplicationCall = true;
+
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		ActivityChangedHandle = UObjectPoolingComponent::OnPooledActorActivityChanged.AddUObject(this, &UReplicationGraphNode_PooledActors::HandlePooledActorActivityChanged);
+	}
+}
+
+void UReplicationGraphNode_PooledActors::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	// Pools spawn their actors idle, so they are only gathered once they are activated
+	PooledActors.Add(ActorInfo.Actor);
+}
+
+bool UReplicationGraphNode_PooledActors::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	if (PooledActors.Remove(ActorInfo.Actor) == 0)
+	{
+		return false;
+	}
+
+	ActiveActors.RemoveFast(ActorInfo.Actor);
+	RetiredActors.RemoveFast(ActorInfo.Actor);
+	PendingRetiredActors.RemoveSingleSwap(ActorInfo.Actor, EAllowShrinking::No);
+	return true;
+}
+
+void UReplicationGraphNode_PooledActors::NotifyResetAllNetworkActors()
+{
+	PooledActors.Reset();
+	ActiveActors.Reset();
+	RetiredActors.Reset();
+	PendingRetiredActors.Reset();
+}
+
+void UReplicationGraphNode_PooledActors::PrepareForReplication()
+{
+	// Actors retired last frame have sent their final update, the ones retired since then get theirs this frame
+	RetiredActors.Reset();
+	for (const FActorRepListType& Actor : PendingRetiredActors)
+	{
+		RetiredActors.Add(Actor);
+	}
+	PendingRetiredActors.Reset();
+}
+
+void UReplicationGraphNode_PooledActors::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	if (ActiveActors.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(ActiveActors);
+	}
+
+	if (RetiredActors.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(RetiredActors);
+	}
+}
+
+void UReplicationGraphNode_PooledActors::TearDown()
+{
+	UObjectPoolingComponent::OnPooledActorActivityChanged.Remove(ActivityChangedHandle);
+	ActivityChangedHandle.Reset();
+
+	Super::TearDown();
+}
+
+void UReplicationGraphNode_PooledActors::HandlePooledActorActivityChanged(AActor* Actor, bool bActive)
+{
+	// Every pool in the process reports here, only actors routed to this node are of interest
+	if (!PooledActors.Contains(Actor))
+	{
+		return;
+	}
+
+	if (bActive)
+	{
+		// A reused actor may not have sent its final update yet, it is gathered through the active list from now on
+		PendingRetiredActors.RemoveSingleSwap(Actor, EAllowShrinking::No);
+		RetiredActors.RemoveFast(Actor);
+		ActiveActors.Add(Actor);
+	}
+	else if (ActiveActors.RemoveFast(Actor))
+	{
+		PendingRetiredActors.Add(Actor);
+	}
+}
@@ -0,0 +1,52 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "PooledActorReplicationGraphNode.generated.h"
+
+/**
+ * Replication graph node for actors pooled with the ReplicationGraph replication policy.  Pooled actors are routed to this node
+ * once, when they are added to the network, and stay routed for the lifetime of the pool.  The node only gathers the active ones,
+ * so idle actors cost nothing in relevancy and reuse never removes or re-adds an actor in the graph.
+ *
+ * Add the node as a global node in your replication graph's InitGlobalGraphNodes and send the pooled classes to it from
+ * RouteAddNetworkActorToNodes and RouteRemoveNetworkActorToNodes.  Per class cull distances still apply to the gathered actors.
+ * The node lives in the DynamicObjectPoolerReplication module, which the game module depends on alongside ReplicationGraph.
+ */
+UCLASS()
+class DYNAMICOBJECTPOOLERREPLICATION_API UReplicationGraphNode_PooledActors : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+
+	UReplicationGraphNode_PooledActors();
+
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+	virtual void NotifyResetAllNetworkActors() override;
+	virtual void PrepareForReplication() override;
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+	virtual void TearDown() override;
+
+private:
+
+	/* Called by the pools whenever a pooled actor is activated or returned */
+	void HandlePooledActorActivityChanged(AActor* Actor, bool bActive);
+
+	/* Every actor routed to this node, active or not */
+	TSet<FActorRepListType> PooledActors;
+
+	/* Actors handed out by their pool.  The only list gathered every frame */
+	FActorRepListRefView ActiveActors;
+
+	/* Actors returned since the last replication frame.  Gathered once more so clients receive the final hidden state */
+	TArray<FActorRepListType> PendingRetiredActors;
+
+	/* Actors gathered for their final update in the current replication frame */
+	FActorRepListRefView RetiredActors;
+
+	FDelegateHandle ActivityChangedHandle;
+};
@@ -0,0 +1,22 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+using UnrealBuildTool;
+
+public class DynamicObjectPoolerTests : ModuleRules
+{
+	public DynamicObjectPoolerTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// Automation tests for the pooler, kept out of the runtime module so shipping games never carry them
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"DynamicObjectPooler",
+			}
+			);
+	}
+}
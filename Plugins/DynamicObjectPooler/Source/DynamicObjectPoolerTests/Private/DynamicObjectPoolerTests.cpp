@@ -0,0 +1,5 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, DynamicObjectPoolerTests)
@@ -0,0 +1,207 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ObjectPoolTestWorld.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+/**
+ * Performance tests for the pool hot paths, run with the Perf filter:
+ *
+ *   Automation RunFilter Perf
+ *
+ * Every measured case has a budget and fails when it goes over, so CI catches regressions.  ObjectPool.PerfBudgetScale loosens
+ * all budgets at once for slow build machines.  Results are logged and written as CSV to Saved/Profiling/ObjectPool for comparison between builds.
+ */
+namespace ObjectPoolPerfTests
+{
+	constexpr EAutomationTestFlags::Type TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter;
+
+	// Budgets per operation.  They sit well above a development build on a desktop machine, so only real regressions fail
+	constexpr double AcquireReturnBudgetNs = 2000.0;
+	constexpr double BatchSpawnReturnBudgetNs = 4000.0;
+	constexpr double LifespanExpiryBudgetNs = 4000.0;
+
+	// A prewarm frame may overrun its time budget by the one spawn that crosses it
+	constexpr double PrewarmFrameOverrunBudgetMs = 2.0;
+
+	static TAutoConsoleVariable<float> CVarPerfBudgetScale(
+		TEXT("ObjectPool.PerfBudgetScale"),
+		1.f,
+		TEXT("Multiplies every object pool performance test budget, for build machines slower than a desktop."));
+
+	/* Collects the timings of one test, checks them against their budgets and writes them out */
+	struct FPerfRun
+	{
+		struct FResult
+		{
+			FString Test;
+			int32 PoolSize;
+			int32 Operations;
+			double Seconds;
+			double BudgetNs;
+		};
+
+		FAutomationTestBase& Test;
+		TArray<FResult> Results;
+
+		explicit FPerfRun(FAutomationTestBase& InTest) : Test(InTest) {}
+
+		/* Records the time since StartTime.  A budget of zero only records it */
+		double AddResult(const TCHAR* Name, int32 PoolSize, int32 Operations, double StartTime, double BudgetNs = 0.0)
+		{
+			return AddSeconds(Name, PoolSize, Operations, FPlatformTime::Seconds() - StartTime, BudgetNs);
+		}
+
+		double AddSeconds(const TCHAR* Name, int32 PoolSize, int32 Operations, double Seconds, double BudgetNs = 0.0)
+		{
+			const FResult& Result = Results.Add_GetRef({ Name, PoolSize, Operations, Seconds, BudgetNs * CVarPerfBudgetScale.GetValueOnGameThread() });
+			const double NsPerOp = Result.Operations > 0 ? Result.Seconds * 1e9 / Result.Operations : 0.0;
+			Test.AddInfo(FString::Printf(TEXT("%-20s Size %6d  %8.3f ms  %10.1f ns/op"), *Result.Test, Result.PoolSize, Result.Seconds * 1000.0, NsPerOp));
+
+			if (Result.BudgetNs > 0.0 && NsPerOp > Result.BudgetNs)
+			{
+				Test.AddError(FString::Printf(TEXT("%s at pool size %d took %.1f ns/op, over its budget of %.1f ns/op."), *Result.Test, Result.PoolSize, NsPerOp, Result.BudgetNs));
+			}
+			return NsPerOp;
+		}
+
+		void WriteResults(const TCHAR* Name) const
+		{
+			FString Csv = TEXT("Test,PoolSize,Operations,TotalMs,NsPerOp,BudgetNsPerOp\n");
+			for (const FResult& Result : Results)
+			{
+				Csv += FString::Printf(TEXT("%s,%d,%d,%.4f,%.2f,%.2f\n"), *Result.Test, Result.PoolSize, Result.Operations,
+					Result.Seconds * 1000.0, Result.Operations > 0 ? Result.Seconds * 1e9 / Result.Operations : 0.0, Result.BudgetNs);
+			}
+
+			const FString FileName = FPaths::ProfilingDir() / TEXT("ObjectPool") / FString::Printf(TEXT("%s-%s.csv"), Name, *FDateTime::Now().ToString());
+			if (FFileHelper::SaveStringToFile(Csv, *FileName))
+			{
+				Test.AddInfo(FString::Printf(TEXT("Pool performance results written to %s"), *FileName));
+			}
+			else
+			{
+				Test.AddWarning(FString::Printf(TEXT("Failed to write pool performance results to %s"), *FileName));
+			}
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FObjectPoolHotPathPerfTest, "DynamicObjectPooler.Performance.HotPaths", ObjectPoolPerfTests::TestFlags)
+bool FObjectPoolHotPathPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace ObjectPoolPerfTests;
+
+	constexpr int32 Iterations = 1000;
+	static const int32 PoolSizes[] = { 10, 100, 1000, 10000 };
+
+	FPerfRun Run(*this);
+	for (const int32 PoolSize : PoolSizes)
+	{
+		// A fresh world per size, so earlier sizes leave no actors behind
+		ObjectPoolTests::FTestWorld TestWorld;
+		UObjectPoolingComponent* Pool = TestWorld.CreatePool(0);
+
+		// The synchronous prewarm is only recorded, the per-frame cost of the async prewarm is budgeted by the prewarm hitch test
+		double Start = FPlatformTime::Seconds();
+		Pool->InitializePool(AStaticMeshActor::StaticClass(), PoolSize);
+		Run.AddResult(TEXT("Prewarm"), PoolSize, PoolSize, Start);
+
+		// Acquire and return pairs on a full reserve
+		Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			Pool->ReturnObjectToPool(Pool->SpawnPooledActor(FTransform::Identity));
+		}
+		const double AcquireReturnNs = Run.AddResult(TEXT("AcquireReturn"), PoolSize, Iterations * 2, Start, AcquireReturnBudgetNs);
+
+		// Drain and refill the whole pool in batches
+		TArray<FTransform> Transforms;
+		Transforms.Init(FTransform::Identity, PoolSize);
+		TArray<AActor*> Actors;
+
+		Start = FPlatformTime::Seconds();
+		Pool->SpawnPooledActors(Transforms, Actors);
+		Pool->ReturnObjectsToPool(Actors);
+		Run.AddResult(TEXT("FullPoolSpawnReturn"), PoolSize, PoolSize * 2, Start, BatchSpawnReturnBudgetNs);
+
+		// Every actor's lifespan runs out in the same frame
+		Pool->ActorLifespan = 1.f;
+		Pool->SpawnPooledActors(Transforms, Actors);
+		TestWorld.AdvanceTime(2.0);
+
+		Start = FPlatformTime::Seconds();
+		FObjectPoolTestAccess::ProcessExpiredLifespans(Pool);
+		Run.AddResult(TEXT("LifespanExpiryStorm"), PoolSize, PoolSize, Start, LifespanExpiryBudgetNs);
+		TestEqual(TEXT("Lifespan storm returns every actor"), Pool->ActiveObjects, 0);
+
+		// Same work as a prewarm and a full pool spawn and return, without the pool.  Reuse has to stay cheaper than this
+		Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < PoolSize; ++i)
+		{
+			if (AActor* Actor = TestWorld.World->SpawnActor<AActor>(AStaticMeshActor::StaticClass()))
+			{
+				Actor->Destroy();
+			}
+		}
+		const double RawSpawnNs = Run.AddResult(TEXT("RawSpawnDestroy"), PoolSize, PoolSize * 2, Start);
+		TestTrue(FString::Printf(TEXT("Pooled acquire and return is cheaper than SpawnActor and Destroy at pool size %d"), PoolSize), AcquireReturnNs < RawSpawnNs);
+	}
+
+	Run.WriteResults(TEXT("HotPaths"));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FObjectPoolPrewarmHitchPerfTest, "DynamicObjectPooler.Performance.PrewarmHitch", ObjectPoolPerfTests::TestFlags)
+bool FObjectPoolPrewarmHitchPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace ObjectPoolPerfTests;
+
+	constexpr int32 PoolSize = 1000;
+
+	ObjectPoolTests::FTestWorld TestWorld;
+	UObjectPoolingComponent* Pool = TestWorld.CreatePool(0);
+	Pool->PrewarmActorsPerFrame = 16;
+	Pool->PrewarmMillisecondsPerFrame = 2.f;
+
+	// The class is already loaded, so the prewarm is queued straight away and only TickPrewarm spawns
+	Pool->InitializePoolAsync(TSoftClassPtr<AActor>(AStaticMeshActor::StaticClass()), PoolSize);
+	if (!TestTrue(TEXT("Async prewarm is queued"), Pool->IsPrewarming()))
+	{
+		return false;
+	}
+
+	// Each call is one frame of the async prewarm, the worst one is the hitch players would see
+	double TotalSeconds = 0.0;
+	double WorstFrameSeconds = 0.0;
+	int32 Frames = 0;
+	while (Pool->IsPrewarming() && Frames <= PoolSize)
+	{
+		const double Start = FPlatformTime::Seconds();
+		FObjectPoolTestAccess::TickPrewarm(Pool);
+		const double FrameSeconds = FPlatformTime::Seconds() - Start;
+
+		TotalSeconds += FrameSeconds;
+		WorstFrameSeconds = FMath::Max(WorstFrameSeconds, FrameSeconds);
+		Frames++;
+	}
+
+	TestFalse(TEXT("Async prewarm finishes"), Pool->IsPrewarming());
+	TestEqual(TEXT("Async prewarm spawns the whole pool"), Pool->GetNumPooledActors(), PoolSize);
+
+	AddInfo(FString::Printf(TEXT("Async prewarm of %d actors took %d frames."), PoolSize, Frames));
+
+	FPerfRun Run(*this);
+	Run.AddSeconds(TEXT("AsyncPrewarm"), PoolSize, PoolSize, TotalSeconds);
+	Run.AddSeconds(TEXT("PrewarmWorstFrame"), PoolSize, 1, WorstFrameSeconds, (Pool->PrewarmMillisecondsPerFrame + PrewarmFrameOverrunBudgetMs) * 1e6);
+	Run.WriteResults(TEXT("PrewarmHitch"));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
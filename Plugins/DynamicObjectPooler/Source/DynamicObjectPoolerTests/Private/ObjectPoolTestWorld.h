@@ -0,0 +1,76 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ObjectPoolingComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+/* Runs the pool steps its tick would run, so tests control exactly when they happen */
+struct FObjectPoolTestAccess
+{
+	static void ProcessExpiredLifespans(UObjectPoolingComponent* Pool) { Pool->ProcessExpiredLifespans(); }
+
+	static void TickPrewarm(UObjectPoolingComponent* Pool) { Pool->TickPrewarm(); }
+};
+
+namespace ObjectPoolTests
+{
+	/* Standalone game world with one host actor, torn down when the test ends.  Time only moves through AdvanceTime */
+	struct FTestWorld
+	{
+		UWorld* World = nullptr;
+		AActor* Host = nullptr;
+
+		FTestWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+			FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+			WorldContext.SetCurrentWorld(World);
+			World->InitializeActorsForPlay(FURL());
+			World->BeginPlay();
+
+			Host = World->SpawnActor<AActor>();
+		}
+
+		~FTestWorld()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+
+		FTestWorld(const FTestWorld&) = delete;
+		FTestWorld& operator=(const FTestWorld&) = delete;
+
+		/* Moves the world clock that pool timestamps and lifespans are read from */
+		void AdvanceTime(double Seconds) const
+		{
+			World->TimeSeconds += Seconds;
+		}
+
+		/* Pool of static mesh actors that never grows on its own.  InitialSize 0 leaves initialization to the caller */
+		UObjectPoolingComponent* CreatePool(int32 InitialSize, EPooledEvictionPolicy EvictionPolicy = EPooledEvictionPolicy::None) const
+		{
+			UObjectPoolingComponent* Pool = NewObject<UObjectPoolingComponent>(Host);
+			Pool->bAutoExpand = false;
+			Pool->bUseTimerLifespan = true;
+			Pool->ActorLifespan = 0.f;
+			Pool->EvictionPolicy = EvictionPolicy;
+			Pool->SetIsReplicated(false);
+			Pool->RegisterComponent();
+			if (InitialSize > 0)
+			{
+				Pool->InitializePool(AStaticMeshActor::StaticClass(), InitialSize);
+			}
+			return Pool;
+		}
+	};
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
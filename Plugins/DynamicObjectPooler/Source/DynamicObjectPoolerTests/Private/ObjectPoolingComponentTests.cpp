@@ -0,0 +1,175 @@
+// Nicholas Bonofiglio @ Pinnacle Gaming Studios
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ObjectPoolTestWorld.h"
+
+namespace ObjectPoolTests
+{
+	constexpr EAutomationTestFlags::Type TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FObjectPoolAcquireReleaseTest, "DynamicObjectPooler.ObjectPoolingComponent.AcquireRelease", ObjectPoolTests::TestFlags)
+bool FObjectPoolAcquireReleaseTest::RunTest(const FString& Parameters)
+{
+	ObjectPoolTests::FTestWorld TestWorld;
+	UObjectPoolingComponent* Pool = TestWorld.CreatePool(2);
+	TestEqual(TEXT("Pool prewarmed to its initial size"), Pool->GetNumPooledActors(), 2);
+
+	AActor* First = Pool->SpawnPooledActor(FTransform::Identity);
+	AActor* Second = Pool->SpawnPooledActor(FTransform::Identity);
+	TestNotNull(TEXT("First acquire succeeds"), First);
+	TestNotNull(TEXT("Second acquire succeeds"), Second);
+	TestTrue(TEXT("Acquires hand out different actors"), First != Second);
+	TestNull(TEXT("Acquire fails once the pool is exhausted"), Pool->SpawnPooledActor(FTransform::Identity));
+	TestEqual(TEXT("Both actors are active"), Pool->ActiveObjects, 2);
+
+	Pool->ReturnObjectToPool(First);
+	TestEqual(TEXT("Return frees one actor"), Pool->InactiveObjects, 1);
+	TestTrue(TEXT("Returned actor is hidden"), First->IsHidden());
+	TestTrue(TEXT("The returned actor is handed out again"), Pool->SpawnPooledActor(FTransform::Identity) == First);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FObjectPoolDoubleReturnTest, "DynamicObjectPooler.ObjectPoolingComponent.DoubleReturn", ObjectPoolTests::TestFlags)
+bool FObjectPoolDoubleReturnTest::RunTest(const FString& Parameters)
+{
+	ObjectPoolTests::FTestWorld TestWorld;
+	UObjectPoolingComponent* Pool = TestWorld.CreatePool(2);
+
+	AActor* Actor = Pool->SpawnPooledActor(FTransform::Identity);
+	Pool->ReturnObjectToPool(Actor);
+	Pool->ReturnObjectToPool(Actor);
+	TestEqual(TEXT("The second return is ignored"), Pool->TotalReturnRequests, 1);
+	TestEqual(TEXT("Active count does not go negative"), Pool->ActiveObjects, 0);
+	TestEqual(TEXT("Inactive count matches the pool size"), Pool->InactiveObjects, 2);
+
+	// A slot pushed twice onto the free list would hand the same actor out twice
+	AActor* First = Pool->SpawnPooledActor(FTransform::Identity);
+	AActor* Second = Pool->SpawnPooledActor(FTransform::Identity);
+	TestTrue(TEXT("Acquires after a double return hand out different actors"), First != Second);
+	TestNull(TEXT("The pool is still exhausted after two acquires"), Pool->SpawnPooledActor(FTransform::Identity));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FObjectPoolStaleHandleTest, "DynamicObjectPooler.ObjectPoolingComponent.StaleHandle", ObjectPoolTests::TestFlags)
+bool FObjectPoolStaleHandleTest::RunTest(const FString& Parameters)
+{
+	ObjectPoolTests::FTestWorld TestWorld;
+	UObjectPoolingComponent* Pool = TestWorld.CreatePool(1);
+
+	const FPooledActorHandle Handle = Pool->SpawnPooledActorHandle(FTransform::Identity);
+	TestTrue(TEXT("Handle is issued"), Handle.IsSet());
+	AActor* Actor = Pool->ResolveHandle(Handle);
+	TestNotNull(TEXT("Live handle resolves"), Actor);
+	TestTrue(TEXT("Live handle can be released"), Pool->ReleaseHandle(Handle));
+	TestNull(TEXT("Released handle no longer resolves"), Pool->ResolveHandle(Handle));
+	TestFalse(TEXT("Released handle cannot be released again"), Pool->ReleaseHandle(Handle));
+
+	// The same slot is reused, the old handle must not reach the new owner's actor
+	const FPooledActorHandle NewHandle = Pool->SpawnPooledActorHandle(FTransform::Identity);
+	TestTrue(TEXT("The slot is reused"), Pool->ResolveHandle(NewHandle) == Actor);
+	TestTrue(TEXT("The reused slot gets a new generation"), NewHandle != Handle);
+	TestNull(TEXT("Stale handle does not resolve to the reused slot"), Pool->ResolveHandle(Handle));
+	TestFalse(TEXT("Stale handle cannot release the reused slot"), Pool->ReleaseHandle(Handle));
+	TestEqual(TEXT("The reused slot is still active"), Pool->ActiveObjects, 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FObjectPoolLifespanExpiryTest, "DynamicObjectPooler.ObjectPoolingComponent.LifespanExpiry", ObjectPoolTests::TestFlags)
+bool FObjectPoolLifespanExpiryTest::RunTest(const FString& Parameters)
+{
+	ObjectPoolTests::FTestWorld TestWorld;
+	UObjectPoolingComponent* Pool = TestWorld.CreatePool(2);
+	Pool->ActorLifespan = 5.f;
+
+	AActor* Expiring = Pool->SpawnPooledActor(FTransform::Identity);
+	AActor* Returned = Pool->SpawnPooledActor(FTransform::Identity);
+
+	// An early return leaves a stale heap entry behind, which must not return the slot's next user
+	Pool->ReturnObjectToPool(Returned);
+	Pool->ActorLifespan = 0.f;
+	AActor* Reused = Pool->SpawnPooledActor(FTransform::Identity);
+	TestTrue(TEXT("The early returned slot is reused"), Reused == Returned);
+
+	TestWorld.AdvanceTime(4.0);
+	FObjectPoolTestAccess::ProcessExpiredLifespans(Pool);
+	TestFalse(TEXT("Actor is kept until its lifespan runs out"), Expiring->IsHidden());
+
+	TestWorld.AdvanceTime(2.0);
+	FObjectPoolTestAccess::ProcessExpiredLifespans(Pool);
+	TestTrue(TEXT("Expired actor is returned and hidden"), Expiring->IsHidden());
+	TestFalse(TEXT("Actor reused without a lifespan stays active"), Reused->IsHidden());
+	TestEqual(TEXT("Only the expired actor was returned"), Pool->ActiveObjects, 1);
+	TestTrue(TEXT("Expired actor was not destroyed"), IsValid(Expiring));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FObjectPoolBatchSpawnTest, "DynamicObjectPooler.ObjectPoolingComponent.BatchSpawn", ObjectPoolTests::TestFlags)
+bool FObjectPoolBatchSpawnTest::RunTest(const FString& Parameters)
+{
+	ObjectPoolTests::FTestWorld TestWorld;
+	UObjectPoolingComponent* Pool = TestWorld.CreatePool(3);
+
+	TArray<FTransform> Transforms;
+	for (int32 i = 0; i < 4; ++i)
+	{
+		Transforms.Add(FTransform(FVector(100.f * i, 0.f, 0.f)));
+	}
+
+	TArray<AActor*> Actors;
+	TestEqual(TEXT("Batch stops when the pool runs dry"), Pool->SpawnPooledActors(Transforms, Actors), 3);
+	TestEqual(TEXT("Every spawned actor is reported"), Actors.Num(), 3);
+	for (int32 i = 0; i < Actors.Num(); ++i)
+	{
+		TestTrue(TEXT("Spawned actor is placed at its transform"), Actors[i]->GetActorLocation().Equals(Transforms[i].GetLocation()));
+	}
+	TestEqual(TEXT("Every actor in the batch is active"), Pool->ActiveObjects, 3);
+
+	Pool->ReturnObjectsToPool(Actors);
+	TestEqual(TEXT("Batch return frees every actor"), Pool->InactiveObjects, 3);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FObjectPoolEvictionTest, "DynamicObjectPooler.ObjectPoolingComponent.Eviction", ObjectPoolTests::TestFlags)
+bool FObjectPoolEvictionTest::RunTest(const FString& Parameters)
+{
+	ObjectPoolTests::FTestWorld TestWorld;
+	UObjectPoolingComponent* Pool = TestWorld.CreatePool(3, EPooledEvictionPolicy::OldestFirst);
+
+	// Spawned a second apart, so every actor has its own activation time
+	AActor* First = Pool->SpawnPooledActor(FTransform::Identity);
+	TestWorld.AdvanceTime(1.0);
+	AActor* Second = Pool->SpawnPooledActor(FTransform::Identity);
+	TestWorld.AdvanceTime(1.0);
+	AActor* Third = Pool->SpawnPooledActor(FTransform::Identity);
+	TestWorld.AdvanceTime(1.0);
+
+	TestTrue(TEXT("Exhausted pool evicts the oldest actor"), Pool->SpawnPooledActor(FTransform::Identity) == First);
+	TestEqual(TEXT("Eviction is counted"), Pool->TotalEvictions, 1);
+	TestEqual(TEXT("Eviction does not change the active count"), Pool->ActiveObjects, 3);
+
+	// The reused actor is now the newest, so the next oldest goes next
+	TestWorld.AdvanceTime(1.0);
+	TestTrue(TEXT("The next eviction takes the next oldest actor"), Pool->SpawnPooledActor(FTransform::Identity) == Second);
+
+	// A returned actor leaves the order, the one after it is evicted instead
+	TestWorld.AdvanceTime(1.0);
+	Pool->ReturnObjectToPool(Third);
+	Pool->SpawnPooledActor(FTransform::Identity);
+	TestWorld.AdvanceTime(1.0);
+	TestTrue(TEXT("Returned actors are skipped by the eviction order"), Pool->SpawnPooledActor(FTransform::Identity) == First);
+	TestEqual(TEXT("Only exhausted spawns evict"), Pool->TotalEvictions, 3);
+
+	// A batch larger than the pool must not evict its own actors and hand them out twice
+	Pool->ReturnObjectsToPool({ First, Second, Third });
+	TArray<AActor*> Actors;
+	Pool->SpawnPooledActors({ FTransform::Identity, FTransform::Identity, FTransform::Identity, FTransform::Identity }, Actors);
+	TestEqual(TEXT("Batch stops once only its own actors are left"), Actors.Num(), 3);
+	TestTrue(TEXT("Batch never hands out an actor twice"), Actors.Num() == 3 && Actors[0] != Actors[1] && Actors[0] != Actors[2] && Actors[1] != Actors[2]);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS